@@ -0,0 +1,104 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import web_server_base
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.const import CONF_ID, CONF_PATH
+
+CODEOWNERS = ["@lyj0309"]
+AUTO_LOAD = ["web_server_base"]
+
+CONF_TIERS = "tiers"
+CONF_RESOLUTION = "resolution"
+CONF_DURATION = "duration"
+CONF_HISTORY = "history"
+
+history_ns = cg.esphome_ns.namespace("history")
+History = history_ns.class_("History", cg.Component)
+
+
+def validate_tier(config):
+    buckets = config[CONF_DURATION].total_milliseconds // config[
+        CONF_RESOLUTION
+    ].total_milliseconds
+    if buckets < 1:
+        raise cv.Invalid(f"{CONF_DURATION} must be at least one {CONF_RESOLUTION}")
+    if buckets > 65535:
+        raise cv.Invalid("A tier can hold at most 65535 buckets")
+    return config
+
+
+def validate_tiers(tiers):
+    for finer, coarser in zip(tiers, tiers[1:]):
+        if (
+            coarser[CONF_RESOLUTION].total_milliseconds
+            % finer[CONF_RESOLUTION].total_milliseconds
+        ):
+            raise cv.Invalid(
+                f"Tier {CONF_RESOLUTION} must be a multiple of the previous tier's"
+            )
+    return tiers
+
+
+TIER_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_RESOLUTION): cv.positive_time_period_milliseconds,
+            cv.Required(CONF_DURATION): cv.positive_time_period_milliseconds,
+        }
+    ),
+    validate_tier,
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(History),
+        cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(
+            web_server_base.WebServerBase
+        ),
+        cv.Optional(CONF_PATH, default="/history"): cv.string,
+        cv.Optional(
+            CONF_TIERS,
+            default=[
+                {CONF_RESOLUTION: "10s", CONF_DURATION: "1h"},
+                {CONF_RESOLUTION: "5min", CONF_DURATION: "24h"},
+            ],
+        ): cv.All(cv.ensure_list(TIER_SCHEMA), cv.Length(min=1), validate_tiers),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def history_id():
+    """Validator for the `history:` option of the sensor platforms, loaded lazily by them."""
+    return cv.use_id(History)
+
+
+async def to_code(config):
+    paren = await cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
+    var = cg.new_Pvariable(config[CONF_ID], paren)
+    await cg.register_component(var, config)
+    cg.add_define("USE_HISTORY")
+
+    cg.add(var.set_path(config[CONF_PATH]))
+    for tier in config[CONF_TIERS]:
+        cg.add(
+            var.add_tier(
+                tier[CONF_RESOLUTION].total_milliseconds,
+                tier[CONF_DURATION].total_milliseconds,
+            )
+        )
+
+
+async def register_history_channels(var, config, channels):
+    """Create history channels for a sensor component.
+
+    channels maps the config key of each decoded value to (divisor, scale): raw
+    units per stored step and physical units per raw unit. Only values that have
+    a sensor configured get a channel, which is handed to set_<key>_history().
+    """
+    if CONF_HISTORY not in config:
+        return
+    history = await cg.get_variable(config[CONF_HISTORY])
+    for key, (divisor, scale) in channels.items():
+        if key in config:
+            channel = history.add_channel(f"{config[CONF_ID].id}.{key}", divisor, scale)
+            cg.add(getattr(var, f"set_{key}_history")(channel))
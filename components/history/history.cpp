@@ -0,0 +1,214 @@
+#include "history.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace history {
+
+static const char *const TAG = "history";
+
+static int16_t clamp_to_bucket(int32_t value) {
+  // HISTORY_EMPTY is reserved, so the lowest storable value is one above it
+  return static_cast<int16_t>(clamp<int32_t>(value, HISTORY_EMPTY + 1, INT16_MAX));
+}
+
+void HistoryChannel::add(int32_t raw) {
+  int16_t value = clamp_to_bucket(raw / this->divisor_);
+  this->feed_(0, value, value, value);
+}
+
+void HistoryChannel::add_ring_(uint16_t capacity) {
+  Ring ring;
+  ring.capacity = capacity;
+  ring.buckets = new HistoryBucket[capacity];  // NOLINT(cppcoreguidelines-owning-memory)
+  this->rings_.push_back(ring);
+}
+
+size_t HistoryChannel::memory_usage() const {
+  size_t usage = sizeof(HistoryChannel) + this->name_.capacity() + this->rings_.size() * sizeof(Ring);
+  for (const Ring &ring : this->rings_) {
+    usage += ring.capacity * sizeof(HistoryBucket);
+  }
+  return usage;
+}
+
+size_t HistoryChannel::export_size() const {
+  // Name, step and tier headers, then at most "-32767," for each value
+  size_t size = 64 + this->name_.size();
+  for (const Ring &ring : this->rings_) {
+    size += 64 + ring.size * 3 * 7;
+  }
+  return size;
+}
+
+void HistoryChannel::feed_(size_t tier, int16_t min, int16_t mean, int16_t max) {
+  Ring &ring = this->rings_[tier];
+  if (ring.acc_count == 0) {
+    ring.acc_min = min;
+    ring.acc_max = max;
+    ring.acc_sum = 0;
+  } else {
+    ring.acc_min = std::min(ring.acc_min, min);
+    ring.acc_max = std::max(ring.acc_max, max);
+  }
+  ring.acc_sum += mean;
+  if (ring.acc_count < UINT16_MAX) {
+    ring.acc_count++;
+  }
+}
+
+void HistoryChannel::commit_(size_t tier) {
+  Ring &ring = this->rings_[tier];
+  HistoryBucket &bucket = ring.buckets[ring.head];
+  if (ring.acc_count == 0) {
+    bucket.min = bucket.mean = bucket.max = HISTORY_EMPTY;
+  } else {
+    bucket.min = ring.acc_min;
+    bucket.mean = clamp_to_bucket(ring.acc_sum / ring.acc_count);
+    bucket.max = ring.acc_max;
+  }
+  ring.acc_count = 0;
+  ring.head = (ring.head + 1) % ring.capacity;
+  if (ring.size < ring.capacity) {
+    ring.size++;
+  }
+
+  // Roll the finished bucket up into the next coarser tier
+  if (bucket.mean != HISTORY_EMPTY && tier + 1 < this->rings_.size()) {
+    this->feed_(tier + 1, bucket.min, bucket.mean, bucket.max);
+  }
+}
+
+// Tiers and channels may be added in any order, each channel always holds one
+// ring per tier
+void History::add_tier(uint32_t resolution, uint32_t duration) {
+  HistoryTier tier{resolution, static_cast<uint16_t>(duration / resolution)};
+  this->tiers_.push_back(tier);
+  for (auto *channel : this->channels_) {
+    channel->add_ring_(tier.capacity);
+  }
+}
+
+HistoryChannel *History::add_channel(const std::string &name, int32_t divisor, float scale) {
+  auto *channel = new HistoryChannel(name, divisor, scale);  // NOLINT(cppcoreguidelines-owning-memory)
+  for (const HistoryTier &tier : this->tiers_) {
+    channel->add_ring_(tier.capacity);
+  }
+  this->channels_.push_back(channel);
+  return channel;
+}
+
+void History::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up History...");
+  uint32_t now = millis();
+  this->tier_start_.assign(this->tiers_.size(), now);
+
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+void History::loop() {
+  uint32_t now = millis();
+  // Finer tiers first so a bucket ending on a shared boundary is rolled up
+  // before the coarser tier closes its own bucket
+  for (size_t tier = 0; tier < this->tiers_.size(); tier++) {
+    while (now - this->tier_start_[tier] >= this->tiers_[tier].resolution) {
+      for (auto *channel : this->channels_) {
+        channel->commit_(tier);
+      }
+      this->tier_start_[tier] += this->tiers_[tier].resolution;
+    }
+  }
+}
+
+void History::dump_config() {
+  ESP_LOGCONFIG(TAG, "History:");
+  ESP_LOGCONFIG(TAG, "  Export Path: %s", this->path_.c_str());
+  for (const HistoryTier &tier : this->tiers_) {
+    ESP_LOGCONFIG(TAG, "  Tier: %u buckets of %us", tier.capacity, tier.resolution / 1000);
+  }
+  size_t total = 0;
+  for (auto *channel : this->channels_) {
+    size_t usage = channel->memory_usage();
+    total += usage;
+    ESP_LOGCONFIG(TAG, "  Channel '%s': %u bytes", channel->get_name().c_str(), (unsigned) usage);
+  }
+  ESP_LOGCONFIG(TAG, "  Total Memory: %u bytes", (unsigned) total);
+}
+
+bool History::canHandle(AsyncWebServerRequest *request) {
+  return request->method() == HTTP_GET && request->url() == this->path_.c_str();
+}
+
+// Export every channel in one JSON document:
+// {"uptime":s,"channels":[{"name":..,"step":..,"tiers":[{"resolution":s,"end":s,"min":[..],"mean":[..],"max":[..]}]}]}
+// Arrays hold stored integers from oldest to newest (multiply by step for physical
+// units), null marks buckets without samples. "end" is the uptime at which the newest
+// bucket closed. ?channel=<name> limits the export to a single channel. Without it,
+// channels that do not fit into HISTORY_MAX_EXPORT_SIZE are listed as
+// {"name":..,"step":..,"omitted":true}.
+void History::handleRequest(AsyncWebServerRequest *request) {
+  std::string filter;
+  if (request->hasArg("channel")) {
+    filter = request->arg("channel").c_str();
+  }
+
+  AsyncResponseStream *stream = request->beginResponseStream("application/json");
+  stream->printf("{\"uptime\":%u,\"channels\":[", millis() / 1000);
+
+  bool first_channel = true;
+  size_t budget = HISTORY_MAX_EXPORT_SIZE;
+  for (auto *channel : this->channels_) {
+    if (!filter.empty() && filter != channel->get_name()) {
+      continue;
+    }
+    if (!first_channel) {
+      stream->print(",");
+    }
+    first_channel = false;
+
+    size_t size = channel->export_size();
+    if (filter.empty() && size > budget) {
+      stream->printf("{\"name\":\"%s\",\"step\":%g,\"omitted\":true}", channel->get_name().c_str(),
+                     channel->get_step());
+      continue;
+    }
+    budget -= std::min(size, budget);
+    this->export_channel_(stream, channel);
+  }
+
+  stream->print("]}");
+  request->send(stream);
+}
+
+void History::export_channel_(AsyncResponseStream *stream, HistoryChannel *channel) {
+  stream->printf("{\"name\":\"%s\",\"step\":%g,\"tiers\":[", channel->get_name().c_str(), channel->get_step());
+
+  for (size_t tier = 0; tier < channel->rings_.size(); tier++) {
+    const HistoryChannel::Ring &ring = channel->rings_[tier];
+    stream->printf("%s{\"resolution\":%u,\"end\":%u", tier == 0 ? "" : ",", this->tiers_[tier].resolution / 1000,
+                   this->tier_start_[tier] / 1000);
+
+    static const char *const FIELDS[] = {"min", "mean", "max"};
+    for (uint8_t field = 0; field < 3; field++) {
+      stream->printf(",\"%s\":[", FIELDS[field]);
+      // Oldest bucket sits at head once the ring is full
+      uint16_t start = (ring.head + ring.capacity - ring.size) % ring.capacity;
+      for (uint16_t i = 0; i < ring.size; i++) {
+        const HistoryBucket &bucket = ring.buckets[(start + i) % ring.capacity];
+        int16_t value = field == 0 ? bucket.min : field == 1 ? bucket.mean : bucket.max;
+        const char *separator = i == 0 ? "" : ",";
+        if (value == HISTORY_EMPTY) {
+          stream->printf("%snull", separator);
+        } else {
+          stream->printf("%s%d", separator, value);
+        }
+      }
+      stream->print("]");
+    }
+    stream->print("}");
+  }
+  stream->print("]}");
+}
+
+}  // namespace history
+}  // namespace esphome
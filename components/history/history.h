@@ -0,0 +1,115 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/web_server_base/web_server_base.h"
+
+namespace esphome {
+namespace history {
+
+// In-RAM multi-resolution history of raw decoder values.
+//
+// Every channel keeps one ring buffer per tier (e.g. 1h at 10s, 24h at 5min).
+// Samples are accumulated into the current bucket of the finest tier; when a
+// bucket period ends its min/mean/max is stored and rolled up into the next
+// tier. Values are stored as packed int16 fixed-point numbers, all memory is
+// allocated while the configuration is built so usage per channel is fixed and
+// sensors set up before History (which waits for the network) can already record.
+
+// Marker for buckets that did not receive any sample
+static const int16_t HISTORY_EMPTY = INT16_MIN;
+// Upper bound for the response of an export without ?channel=. The response is
+// buffered in RAM before it is sent, channels that would exceed it are listed
+// without data and have to be fetched one at a time.
+static const size_t HISTORY_MAX_EXPORT_SIZE = 16384;
+
+// One stored bucket, in units of divisor raw units
+struct HistoryBucket {
+  int16_t min;
+  int16_t mean;
+  int16_t max;
+};
+
+struct HistoryTier {
+  uint32_t resolution;  // Bucket length in ms
+  uint16_t capacity;    // Number of buckets kept
+};
+
+class HistoryChannel {
+ public:
+  // divisor: raw decoder units per stored step, scale: physical units per raw unit
+  HistoryChannel(std::string name, int32_t divisor, float scale)
+      : name_(std::move(name)), divisor_(divisor), scale_(scale) {}
+
+  // Add one raw sample as produced by the decoder
+  void add(int32_t raw);
+
+  const std::string &get_name() const { return name_; }
+  // Physical units per stored step
+  float get_step() const { return divisor_ * scale_; }
+  size_t memory_usage() const;
+  // Upper bound for the size of this channel's entry in the JSON export
+  size_t export_size() const;
+
+ protected:
+  friend class History;
+
+  struct Ring {
+    HistoryBucket *buckets{nullptr};
+    uint16_t capacity{0};
+    uint16_t head{0};  // Next slot to write
+    uint16_t size{0};
+    // Bucket currently being accumulated
+    int16_t acc_min{0};
+    int16_t acc_max{0};
+    int32_t acc_sum{0};
+    uint16_t acc_count{0};
+  };
+
+  void add_ring_(uint16_t capacity);
+  void feed_(size_t tier, int16_t min, int16_t mean, int16_t max);
+  void commit_(size_t tier);
+
+  std::string name_;
+  int32_t divisor_;
+  float scale_;
+  std::vector<Ring> rings_;
+};
+
+// Null safe helper for the sensor components
+inline void record(HistoryChannel *channel, int32_t raw) {
+  if (channel != nullptr) {
+    channel->add(raw);
+  }
+}
+
+class History : public AsyncWebHandler, public Component {
+ public:
+  History(web_server_base::WebServerBase *base) : base_(base) {}
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::WIFI - 1.0f; }
+
+  void set_path(const std::string &path) { path_ = path; }
+  void add_tier(uint32_t resolution, uint32_t duration);
+  // Called by the sensor components while the configuration is built
+  HistoryChannel *add_channel(const std::string &name, int32_t divisor, float scale);
+
+  bool canHandle(AsyncWebServerRequest *request) override;
+  void handleRequest(AsyncWebServerRequest *request) override;
+  bool isRequestHandlerTrivial() override { return false; }
+
+ protected:
+  void export_channel_(AsyncResponseStream *stream, HistoryChannel *channel);
+
+  web_server_base::WebServerBase *base_;
+  std::string path_{"/history"};
+  std::vector<HistoryTier> tiers_;
+  std::vector<uint32_t> tier_start_;
+  std::vector<HistoryChannel *> channels_;
+};
+
+}  // namespace history
+}  // namespace esphome
@@ -31,17 +31,40 @@ void JXCO2102Sensor::update() {
 }
 
 void JXCO2102Sensor::loop() {
+  if (this->hub_managed_) {
+    return;
+  }
+  this->service(SIZE_MAX);
+}
+
+size_t JXCO2102Sensor::service(size_t max_bytes, bool resume) {
+#ifdef USE_LOOP_PROFILER
+  uint32_t loop_start = this->profiler_ != nullptr ? loop_profiler::LoopProfiler::begin() : 0;
+#endif
+  size_t bytes_read = 0;
+  
   // Read available data from UART
-  while (this->available()) {
+  while (bytes_read < max_bytes && this->available()) {
     uint8_t byte;
     this->read_byte(&byte);
+    bytes_read++;
     
     // Add byte to buffer
     this->rx_buffer_.push_back(byte);
     
     // Check if we have a complete line (ending with \n)
     if (byte == '\n') {
-      if (this->parse_ascii_data_()) {
+#ifdef USE_LOOP_PROFILER
+      uint32_t parse_start = this->profiler_ != nullptr ? loop_profiler::LoopProfiler::begin() : 0;
+#endif
+      bool parsed = this->parse_ascii_data_();
+#ifdef USE_LOOP_PROFILER
+      if (this->profiler_ != nullptr) {
+        this->profiler_->record_parse(parse_start);
+      }
+#endif
+      if (parsed) {
+        this->frame_count_++;
         ESP_LOGV(TAG, "Successfully parsed CO2 data");
       } else {
         ESP_LOGW(TAG, "Invalid data packet received");
@@ -55,6 +78,13 @@ void JXCO2102Sensor::loop() {
     ESP_LOGW(TAG, "Buffer overflow, clearing");
     this->rx_buffer_.clear();
   }
+  
+#ifdef USE_LOOP_PROFILER
+  if (this->profiler_ != nullptr) {
+    this->profiler_->record_loop(loop_start, bytes_read, resume);
+  }
+#endif
+  return bytes_read;
 }
 
 uint8_t JXCO2102Sensor::jx_co2_checksum_(const uint8_t *data, uint8_t len) {
@@ -136,62 +166,41 @@ void JXCO2102Sensor::calibrate_zero() {
 }
 
 bool JXCO2102Sensor::parse_ascii_data_() {
-  // Expected format: "  xxxx ppm\r\n" or similar
-  // Example: "  1235 ppm\r\n"
-  // In hex: 20 20 31 32 33 35 20 70 70 6d 0D 0A
-  
+  // Line format is described in jx_co2_102_frame.h
   if (this->rx_buffer_.empty()) {
     return false;
   }
   
-  // Convert buffer to string
-  std::string data_str(this->rx_buffer_.begin(), this->rx_buffer_.end());
-  
-  // Remove leading/trailing whitespace and control characters
-  size_t start = data_str.find_first_not_of(" \t\r\n");
-  if (start == std::string::npos) {
-    return false;
-  }
-  
-  size_t end = data_str.find_last_not_of(" \t\r\n");
-  data_str = data_str.substr(start, end - start + 1);
-  
-  // Look for "ppm" in the string
-  size_t ppm_pos = data_str.find("ppm");
-  if (ppm_pos == std::string::npos) {
-    ESP_LOGV(TAG, "No 'ppm' found in data");
-    return false;
-  }
-  
-  // Extract the numeric part before "ppm"
-  std::string num_str = data_str.substr(0, ppm_pos);
-  
-  // Remove any remaining whitespace
-  start = num_str.find_first_not_of(" \t");
-  if (start == std::string::npos) {
-    return false;
+  long parsed_value = 0;
+  char number[MAX_LINE_LENGTH + 1];
+  switch (parse_line(this->rx_buffer_.data(), this->rx_buffer_.size(), &parsed_value, number)) {
+    case LINE_OK:
+      break;
+    case LINE_NO_PPM:
+      ESP_LOGV(TAG, "No 'ppm' found in data");
+      return false;
+    case LINE_BAD_NUMBER:
+      ESP_LOGW(TAG, "Failed to parse CO2 value: '%s'", number);
+      return false;
+    case LINE_OUT_OF_RANGE:
+      ESP_LOGW(TAG, "CO2 value out of range: %ld ppm", parsed_value);
+      return false;
+    default:
+      return false;
   }
-  end = num_str.find_last_not_of(" \t");
-  num_str = num_str.substr(start, end - start + 1);
-  
-  // Parse the number
-  char *endptr;
-  long parsed_value = strtol(num_str.c_str(), &endptr, 10);
   
-  // Check if parsing was successful
-  if (endptr == num_str.c_str() || *endptr != '\0') {
-    ESP_LOGW(TAG, "Failed to parse CO2 value: '%s'", num_str.c_str());
-    return false;
-  }
+  int co2_value = static_cast<int>(parsed_value);
   
-  // Validate range (0-50000 ppm based on spec)
-  // CO2 values cannot be negative, and max range is 50000 ppm
-  if (parsed_value < 0 || parsed_value > 50000) {
-    ESP_LOGW(TAG, "CO2 value out of range: %ld ppm", parsed_value);
-    return false;
+#ifdef USE_THRESHOLD_TRIGGER
+  // Evaluate threshold triggers on the raw value first
+  for (auto *trigger : this->co2_triggers_) {
+    trigger->process(co2_value);
   }
+#endif
   
-  int co2_value = static_cast<int>(parsed_value);
+#ifdef USE_HISTORY
+  history::record(this->co2_history_, co2_value);
+#endif
   
   // Publish the value
   if (this->co2_sensor_ != nullptr) {
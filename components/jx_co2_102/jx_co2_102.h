@@ -1,10 +1,21 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/sensor/sensor.h"
+#ifdef USE_THRESHOLD_TRIGGER
+#include "esphome/components/threshold_trigger/threshold_trigger.h"
+#endif
+#ifdef USE_LOOP_PROFILER
+#include "esphome/components/loop_profiler/loop_profiler.h"
+#endif
+#ifdef USE_HISTORY
+#include "esphome/components/history/history.h"
+#endif
 #include "esphome/components/uart/uart.h"
+#include "jx_co2_102_frame.h"
 
 namespace esphome {
 namespace jx_co2_102 {
@@ -24,7 +35,23 @@ class JXCO2102Sensor : public PollingComponent, public uart::UARTDevice {
   void loop() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
+  // Drain at most max_bytes of UART input, returns the number of bytes consumed.
+  // Called from loop() unless a sensor_hub schedules this sensor; resume marks a
+  // second call within the same hub iteration, profiled as part of the first one.
+  size_t service(size_t max_bytes, bool resume = false);
+  void set_hub_managed(bool hub_managed) { hub_managed_ = hub_managed; }
+  uint32_t get_frame_count() const { return frame_count_; }
+
   void set_co2_sensor(sensor::Sensor *co2_sensor) { co2_sensor_ = co2_sensor; }
+#ifdef USE_THRESHOLD_TRIGGER
+  void add_co2_trigger(threshold_trigger::ThresholdTrigger *trigger) { co2_triggers_.push_back(trigger); }
+#endif
+#ifdef USE_LOOP_PROFILER
+  void set_profiler(loop_profiler::LoopProfiler *profiler) { profiler_ = profiler; }
+#endif
+#ifdef USE_HISTORY
+  void set_co2_history(history::HistoryChannel *co2_history) { co2_history_ = co2_history; }
+#endif
   
   void calibrate_zero();
 
@@ -34,8 +61,19 @@ class JXCO2102Sensor : public PollingComponent, public uart::UARTDevice {
   uint8_t jx_co2_checksum_(const uint8_t *data, uint8_t len);
 
   sensor::Sensor *co2_sensor_{nullptr};
+#ifdef USE_THRESHOLD_TRIGGER
+  std::vector<threshold_trigger::ThresholdTrigger *> co2_triggers_;
+#endif
+#ifdef USE_LOOP_PROFILER
+  loop_profiler::LoopProfiler *profiler_{nullptr};
+#endif
+#ifdef USE_HISTORY
+  history::HistoryChannel *co2_history_{nullptr};
+#endif
 
   std::vector<uint8_t> rx_buffer_;
+  bool hub_managed_{false};
+  uint32_t frame_count_{0};
 };
 
 template<typename... Ts> class JXCO2102CalibrateZeroAction : public Action<Ts...> {
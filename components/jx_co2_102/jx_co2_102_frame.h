@@ -0,0 +1,90 @@
+#pragma once
+
+// JX-CO2-102 active reporting line format shared by the ESPHome component and the
+// host-side capture decoder (tools/uart_capture_decoder). Must not depend on ESPHome.
+//
+// Expected format: "  xxxx ppm\r\n" or similar
+// Example: "  1235 ppm\r\n"
+// In hex: 20 20 31 32 33 35 20 70 70 6d 0D 0A
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace esphome {
+namespace jx_co2_102 {
+
+static const uint8_t LINE_TERMINATOR = '\n';
+// Longer lines are treated as garbage
+static const uint8_t MAX_LINE_LENGTH = 20;
+// Valid range (0-50000 ppm based on spec)
+static const long MAX_CO2_PPM = 50000;
+
+enum LineParseResult {
+  LINE_OK = 0,
+  LINE_EMPTY,
+  LINE_NO_PPM,
+  LINE_BAD_NUMBER,
+  LINE_OUT_OF_RANGE,
+};
+
+inline bool is_line_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// Parse one line (terminator included or not). On LINE_OK and LINE_OUT_OF_RANGE
+// *ppm holds the parsed value; on LINE_BAD_NUMBER number holds the rejected text.
+inline LineParseResult parse_line(const uint8_t *data, size_t len, long *ppm, char (&number)[MAX_LINE_LENGTH + 1]) {
+  const char *begin = reinterpret_cast<const char *>(data);
+  const char *end = begin + len;
+  number[0] = '\0';
+
+  // Remove leading/trailing whitespace and control characters
+  while (begin < end && is_line_space(*begin))
+    begin++;
+  while (end > begin && is_line_space(end[-1]))
+    end--;
+  if (begin == end) {
+    return LINE_EMPTY;
+  }
+
+  // Look for "ppm" and take the numeric part before it
+  const char *ppm_pos = nullptr;
+  for (const char *p = begin; p + 3 <= end; p++) {
+    if (p[0] == 'p' && p[1] == 'p' && p[2] == 'm') {
+      ppm_pos = p;
+      break;
+    }
+  }
+  if (ppm_pos == nullptr) {
+    return LINE_NO_PPM;
+  }
+
+  const char *num_end = ppm_pos;
+  while (begin < num_end && (*begin == ' ' || *begin == '\t'))
+    begin++;
+  while (num_end > begin && (num_end[-1] == ' ' || num_end[-1] == '\t'))
+    num_end--;
+  if (begin == num_end || num_end - begin > MAX_LINE_LENGTH) {
+    return LINE_EMPTY;
+  }
+  size_t num_len = num_end - begin;
+  memcpy(number, begin, num_len);
+  number[num_len] = '\0';
+
+  // The whole numeric part has to be consumed
+  char *endptr;
+  long parsed_value = strtol(number, &endptr, 10);
+  if (endptr == number || *endptr != '\0') {
+    return LINE_BAD_NUMBER;
+  }
+
+  *ppm = parsed_value;
+  // CO2 values cannot be negative, and max range is 50000 ppm
+  if (parsed_value < 0 || parsed_value > MAX_CO2_PPM) {
+    return LINE_OUT_OF_RANGE;
+  }
+  return LINE_OK;
+}
+
+}  // namespace jx_co2_102
+}  // namespace esphome
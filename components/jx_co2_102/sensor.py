@@ -1,3 +1,5 @@
+import importlib
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
@@ -14,6 +16,10 @@ from esphome.const import (
 CODEOWNERS = ["@lyj0309"]
 DEPENDENCIES = ["uart"]
 
+CONF_PROFILING = "profiling"
+CONF_HISTORY = "history"
+CONF_ON_CO2_ABOVE = "on_co2_above"
+CONF_ON_CO2_BELOW = "on_co2_below"
 ICON_MOLECULE_CO2 = "mdi:molecule-co2"
 
 jx_co2_102_ns = cg.esphome_ns.namespace("jx_co2_102")
@@ -25,6 +31,18 @@ JXCO2102CalibrateZeroAction = jx_co2_102_ns.class_(
     automation.Action,
 )
 
+
+def optional_component(component, schema, *args):
+    # Optional components are only imported when their option is used, so they do
+    # not have to be listed in external_components otherwise
+    def validator(value):
+        cv.requires_component(component)(value)
+        module = importlib.import_module(f"esphome.components.{component}")
+        return getattr(module, schema)(*args)(value)
+
+    return validator
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -36,6 +54,10 @@ CONFIG_SCHEMA = cv.All(
                 device_class=DEVICE_CLASS_CARBON_DIOXIDE,
                 state_class=STATE_CLASS_MEASUREMENT,
             ),
+            cv.Optional(CONF_ON_CO2_ABOVE): optional_component("threshold_trigger", "triggers_schema", 50000),
+            cv.Optional(CONF_ON_CO2_BELOW): optional_component("threshold_trigger", "triggers_schema", 50000),
+            cv.Optional(CONF_PROFILING): optional_component("loop_profiler", "profiling_schema"),
+            cv.Optional(CONF_HISTORY): optional_component("history", "history_id"),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -53,6 +75,27 @@ async def to_code(config):
         sens = await sensor.new_sensor(config[CONF_CO2])
         cg.add(var.set_co2_sensor(sens))
 
+    if CONF_ON_CO2_ABOVE in config or CONF_ON_CO2_BELOW in config:
+        from esphome.components import threshold_trigger
+
+        await threshold_trigger.build_threshold_triggers(
+            var, config, CONF_ON_CO2_ABOVE, CONF_ON_CO2_BELOW, "add_co2_trigger"
+        )
+
+    if CONF_PROFILING in config:
+        from esphome.components import loop_profiler
+
+        profiler = await loop_profiler.new_loop_profiler(
+            config[CONF_PROFILING], "jx_co2_102"
+        )
+        cg.add(var.set_profiler(profiler))
+
+    if CONF_HISTORY in config:
+        from esphome.components import history
+
+        # 2 ppm steps keep the 50000 ppm range within the packed 16 bit storage
+        await history.register_history_channels(var, config, {CONF_CO2: (2, 1.0)})
+
 
 CALIBRATION_ACTION_SCHEMA = maybe_simple_id(
     {
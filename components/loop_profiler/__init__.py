@@ -0,0 +1,118 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import automation
+from esphome.automation import maybe_simple_id
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_PERCENT,
+)
+
+CODEOWNERS = ["@lyj0309"]
+DEPENDENCIES = ["sensor"]
+
+CONF_LOOP_TIME = "loop_time"
+CONF_LOOP_TIME_MAX = "loop_time_max"
+CONF_LOOP_LOAD = "loop_load"
+CONF_LOOP_RATE = "loop_rate"
+CONF_PARSE_TIME = "parse_time"
+CONF_PARSE_TIME_MAX = "parse_time_max"
+CONF_BYTES_PER_CALL = "bytes_per_call"
+UNIT_MICROSECOND = "µs"
+UNIT_BYTES = "B"
+UNIT_CALLS_PER_SECOND = "calls/s"
+ICON_TIMER = "mdi:timer-outline"
+ICON_GAUGE = "mdi:gauge"
+
+loop_profiler_ns = cg.esphome_ns.namespace("loop_profiler")
+LoopProfiler = loop_profiler_ns.class_("LoopProfiler", cg.PollingComponent)
+LoopProfilerResetAction = loop_profiler_ns.class_(
+    "LoopProfilerResetAction", automation.Action
+)
+
+
+def _diagnostic_sensor(unit, icon, accuracy_decimals):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        icon=icon,
+        accuracy_decimals=accuracy_decimals,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+# Makes the `profiling:` option of the sensor platforms available
+CONFIG_SCHEMA = cv.Schema({})
+
+# Schema for the `profiling:` block of the sensor platforms in this repository
+PROFILING_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(LoopProfiler),
+        cv.Optional(CONF_LOOP_TIME): _diagnostic_sensor(
+            UNIT_MICROSECOND, ICON_TIMER, 1
+        ),
+        cv.Optional(CONF_LOOP_TIME_MAX): _diagnostic_sensor(
+            UNIT_MICROSECOND, ICON_TIMER, 0
+        ),
+        cv.Optional(CONF_LOOP_LOAD): _diagnostic_sensor(UNIT_PERCENT, ICON_GAUGE, 3),
+        cv.Optional(CONF_LOOP_RATE): _diagnostic_sensor(
+            UNIT_CALLS_PER_SECOND, ICON_GAUGE, 1
+        ),
+        cv.Optional(CONF_PARSE_TIME): _diagnostic_sensor(
+            UNIT_MICROSECOND, ICON_TIMER, 1
+        ),
+        cv.Optional(CONF_PARSE_TIME_MAX): _diagnostic_sensor(
+            UNIT_MICROSECOND, ICON_TIMER, 0
+        ),
+        cv.Optional(CONF_BYTES_PER_CALL): _diagnostic_sensor(UNIT_BYTES, ICON_GAUGE, 2),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+def profiling_schema():
+    """Validator for the `profiling:` option, loaded lazily by the sensor platforms."""
+    return PROFILING_SCHEMA
+
+
+SENSORS = {
+    CONF_LOOP_TIME: "set_loop_time_sensor",
+    CONF_LOOP_TIME_MAX: "set_loop_time_max_sensor",
+    CONF_LOOP_LOAD: "set_loop_load_sensor",
+    CONF_LOOP_RATE: "set_loop_rate_sensor",
+    CONF_PARSE_TIME: "set_parse_time_sensor",
+    CONF_PARSE_TIME_MAX: "set_parse_time_max_sensor",
+    CONF_BYTES_PER_CALL: "set_bytes_per_call_sensor",
+}
+
+
+async def new_loop_profiler(config, source):
+    cg.add_define("USE_LOOP_PROFILER")
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_source(source))
+
+    for key, setter in SENSORS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+
+    return var
+
+
+RESET_ACTION_SCHEMA = maybe_simple_id(
+    {
+        cv.GenerateID(): cv.use_id(LoopProfiler),
+    }
+)
+
+
+@automation.register_action(
+    "loop_profiler.reset",
+    LoopProfilerResetAction,
+    RESET_ACTION_SCHEMA,
+)
+async def loop_profiler_reset_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
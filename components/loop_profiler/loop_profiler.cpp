@@ -0,0 +1,110 @@
+#include "loop_profiler.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace loop_profiler {
+
+static const char *const TAG = "loop_profiler";
+
+void LoopProfiler::setup() { this->reset(); }
+
+void LoopProfiler::dump_config() {
+  ESP_LOGCONFIG(TAG, "Loop Profiler for '%s':", this->source_);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Loop Time", this->loop_time_sensor_);
+  LOG_SENSOR("  ", "Loop Time Max", this->loop_time_max_sensor_);
+  LOG_SENSOR("  ", "Loop Load", this->loop_load_sensor_);
+  LOG_SENSOR("  ", "Loop Rate", this->loop_rate_sensor_);
+  LOG_SENSOR("  ", "Parse Time", this->parse_time_sensor_);
+  LOG_SENSOR("  ", "Parse Time Max", this->parse_time_max_sensor_);
+  LOG_SENSOR("  ", "Bytes Per Call", this->bytes_per_call_sensor_);
+}
+
+void LoopProfiler::record_loop(uint32_t start, size_t bytes, bool resume) {
+  // Unsigned subtraction handles the cycle counter wrapping around
+  uint32_t cycles = arch_get_cpu_cycle_count() - start;
+  if (resume && this->loop_calls_ > 0) {
+    this->last_loop_cycles_ += cycles;
+  } else {
+    this->last_loop_cycles_ = cycles;
+    this->loop_calls_++;
+  }
+  this->loop_cycles_ += cycles;
+  this->loop_cycles_max_ = std::max(this->loop_cycles_max_, this->last_loop_cycles_);
+  this->bytes_ += bytes;
+}
+
+void LoopProfiler::record_parse(uint32_t start) {
+  uint32_t cycles = arch_get_cpu_cycle_count() - start;
+  this->parse_cycles_ += cycles;
+  this->parse_cycles_max_ = std::max(this->parse_cycles_max_, cycles);
+  this->parse_calls_++;
+}
+
+void LoopProfiler::reset() {
+  this->loop_cycles_ = 0;
+  this->loop_cycles_max_ = 0;
+  this->loop_calls_ = 0;
+  this->parse_cycles_ = 0;
+  this->parse_cycles_max_ = 0;
+  this->parse_calls_ = 0;
+  this->bytes_ = 0;
+  this->reset_time_ = millis();
+  ESP_LOGD(TAG, "'%s' statistics reset", this->source_);
+}
+
+float LoopProfiler::cycles_to_us_(uint64_t cycles) const {
+  return cycles / (arch_get_cpu_freq_hz() / 1000000.0f);
+}
+
+void LoopProfiler::update() {
+  uint32_t elapsed_ms = millis() - this->reset_time_;
+  if (this->loop_calls_ == 0 || elapsed_ms == 0) {
+    return;
+  }
+
+  float loop_time = this->cycles_to_us_(this->loop_cycles_) / this->loop_calls_;
+  float loop_time_max = this->cycles_to_us_(this->loop_cycles_max_);
+  // Share of wall clock time spent inside loop()
+  float loop_load = this->cycles_to_us_(this->loop_cycles_) / (elapsed_ms * 1000.0f) * 100.0f;
+  float loop_rate = this->loop_calls_ * 1000.0f / elapsed_ms;
+  float bytes_per_call = static_cast<float>(this->bytes_) / this->loop_calls_;
+
+  ESP_LOGD(TAG, "'%s' loop: avg %.1f us, max %.0f us, load %.3f %%, %.1f calls/s, %.2f bytes/call", this->source_,
+           loop_time, loop_time_max, loop_load, loop_rate, bytes_per_call);
+
+  if (this->loop_time_sensor_ != nullptr) {
+    this->loop_time_sensor_->publish_state(loop_time);
+  }
+  if (this->loop_time_max_sensor_ != nullptr) {
+    this->loop_time_max_sensor_->publish_state(loop_time_max);
+  }
+  if (this->loop_load_sensor_ != nullptr) {
+    this->loop_load_sensor_->publish_state(loop_load);
+  }
+  if (this->loop_rate_sensor_ != nullptr) {
+    this->loop_rate_sensor_->publish_state(loop_rate);
+  }
+  if (this->bytes_per_call_sensor_ != nullptr) {
+    this->bytes_per_call_sensor_->publish_state(bytes_per_call);
+  }
+
+  if (this->parse_calls_ == 0) {
+    return;
+  }
+
+  float parse_time = this->cycles_to_us_(this->parse_cycles_) / this->parse_calls_;
+  float parse_time_max = this->cycles_to_us_(this->parse_cycles_max_);
+  ESP_LOGD(TAG, "'%s' parse: avg %.1f us, max %.0f us over %u calls", this->source_, parse_time, parse_time_max,
+           this->parse_calls_);
+
+  if (this->parse_time_sensor_ != nullptr) {
+    this->parse_time_sensor_->publish_state(parse_time);
+  }
+  if (this->parse_time_max_sensor_ != nullptr) {
+    this->parse_time_max_sensor_->publish_state(parse_time_max);
+  }
+}
+
+}  // namespace loop_profiler
+}  // namespace esphome
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace loop_profiler {
+
+// CPU cycle accounting for a sensor component's loop() and parse routine.
+// The owning component calls begin() at the start of the measured section and
+// record_loop()/record_parse() with the returned cycle count at the end.
+// Statistics accumulate until reset() and are published every update_interval.
+class LoopProfiler : public PollingComponent {
+ public:
+  LoopProfiler() = default;
+
+  void setup() override;
+  void dump_config() override;
+  void update() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void set_source(const char *source) { source_ = source; }
+  void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
+  void set_loop_time_max_sensor(sensor::Sensor *loop_time_max_sensor) { loop_time_max_sensor_ = loop_time_max_sensor; }
+  void set_loop_load_sensor(sensor::Sensor *loop_load_sensor) { loop_load_sensor_ = loop_load_sensor; }
+  void set_loop_rate_sensor(sensor::Sensor *loop_rate_sensor) { loop_rate_sensor_ = loop_rate_sensor; }
+  void set_parse_time_sensor(sensor::Sensor *parse_time_sensor) { parse_time_sensor_ = parse_time_sensor; }
+  void set_parse_time_max_sensor(sensor::Sensor *parse_time_max_sensor) {
+    parse_time_max_sensor_ = parse_time_max_sensor;
+  }
+  void set_bytes_per_call_sensor(sensor::Sensor *bytes_per_call_sensor) {
+    bytes_per_call_sensor_ = bytes_per_call_sensor;
+  }
+
+  static uint32_t begin() { return arch_get_cpu_cycle_count(); }
+  // resume adds to the previous call instead of counting a new one, for a sensor_hub
+  // servicing a sensor a second time within one of its iterations
+  void record_loop(uint32_t start, size_t bytes, bool resume = false);
+  void record_parse(uint32_t start);
+  void reset();
+
+ protected:
+  float cycles_to_us_(uint64_t cycles) const;
+
+  const char *source_{""};
+  sensor::Sensor *loop_time_sensor_{nullptr};
+  sensor::Sensor *loop_time_max_sensor_{nullptr};
+  sensor::Sensor *loop_load_sensor_{nullptr};
+  sensor::Sensor *loop_rate_sensor_{nullptr};
+  sensor::Sensor *parse_time_sensor_{nullptr};
+  sensor::Sensor *parse_time_max_sensor_{nullptr};
+  sensor::Sensor *bytes_per_call_sensor_{nullptr};
+
+  uint64_t loop_cycles_{0};
+  uint32_t loop_cycles_max_{0};
+  uint32_t last_loop_cycles_{0};
+  uint32_t loop_calls_{0};
+  uint64_t parse_cycles_{0};
+  uint32_t parse_cycles_max_{0};
+  uint32_t parse_calls_{0};
+  uint64_t bytes_{0};
+  uint32_t reset_time_{0};
+};
+
+template<typename... Ts> class LoopProfilerResetAction : public Action<Ts...> {
+ public:
+  LoopProfilerResetAction(LoopProfiler *loop_profiler) : loop_profiler_(loop_profiler) {}
+
+  void play(Ts... x) override { this->loop_profiler_->reset(); }
+
+ protected:
+  LoopProfiler *loop_profiler_;
+};
+
+}  // namespace loop_profiler
+}  // namespace esphome
@@ -19,14 +19,34 @@ void PM2005Sensor::dump_config() {
   LOG_SENSOR("  ", "PM10", this->pm_10_0_sensor_);
   LOG_SENSOR("  ", "PM2.5 Mass", this->pm_2_5_mass_sensor_);
   LOG_SENSOR("  ", "PM10 Mass", this->pm_10_0_mass_sensor_);
+  if (this->adaptive_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive Interval: %us - %us, change threshold %.0f%%", this->min_interval_ / 1000,
+                  this->max_interval_ / 1000, this->change_threshold_ * 100.0f);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Measurement Interval: %us", this->measurement_interval_ / 1000);
+  }
+  LOG_SENSOR("  ", "Measurement Interval", this->measurement_interval_sensor_);
   this->check_uart_settings(9600);
 }
 
 void PM2005Sensor::loop() {
+  if (this->hub_managed_) {
+    return;
+  }
+  this->service(SIZE_MAX);
+}
+
+size_t PM2005Sensor::service(size_t max_bytes, bool resume) {
+#ifdef USE_LOOP_PROFILER
+  uint32_t loop_start = this->profiler_ != nullptr ? loop_profiler::LoopProfiler::begin() : 0;
+#endif
+  size_t bytes_read = 0;
+  
   // Read available data from UART
-  while (this->available()) {
+  while (bytes_read < max_bytes && this->available()) {
     uint8_t byte;
     this->read_byte(&byte);
+    bytes_read++;
     
     // Add byte to buffer
     this->rx_buffer_.push_back(byte);
@@ -35,11 +55,21 @@ void PM2005Sensor::loop() {
     if (this->rx_buffer_.size() >= PM2005_RESP_HEADER_LEN) {
       // Check for valid header
       if (this->rx_buffer_[0] == PM2005_RESP_HEADER) {
-        uint8_t expected_len = this->rx_buffer_[1] + 3;  // LEN + HEADER + LEN + CS
+        uint16_t expected_len = pm2005_frame_length(this->rx_buffer_[1]);
         
         // Wait for complete packet
         if (this->rx_buffer_.size() >= expected_len) {
-          if (this->parse_response_()) {
+#ifdef USE_LOOP_PROFILER
+          uint32_t parse_start = this->profiler_ != nullptr ? loop_profiler::LoopProfiler::begin() : 0;
+#endif
+          bool parsed = this->parse_response_();
+#ifdef USE_LOOP_PROFILER
+          if (this->profiler_ != nullptr) {
+            this->profiler_->record_parse(parse_start);
+          }
+#endif
+          if (parsed) {
+            this->frame_count_++;
             ESP_LOGV(TAG, "Successfully parsed response");
           } else {
             ESP_LOGW(TAG, "Invalid response packet received");
@@ -64,8 +94,8 @@ void PM2005Sensor::loop() {
   
   switch (this->state_) {
     case PM2005_STATE_IDLE:
-      // Start measurement every 60 seconds
-      if (now - this->last_measurement_time_ > PM2005_MEASUREMENT_INTERVAL) {
+      // Start measurement every interval (60 seconds unless adaptive)
+      if (this->start_allowed_ && now - this->last_measurement_time_ > this->measurement_interval_) {
         this->open_measurement_();
         this->state_ = PM2005_STATE_WAIT_RESPONSE;
         this->last_command_time_ = now;
@@ -99,6 +129,13 @@ void PM2005Sensor::loop() {
       }
       break;
   }
+  
+#ifdef USE_LOOP_PROFILER
+  if (this->profiler_ != nullptr) {
+    this->profiler_->record_loop(loop_start, bytes_read, resume);
+  }
+#endif
+  return bytes_read;
 }
 
 void PM2005Sensor::send_command_(uint8_t cmd, const uint8_t *data, uint8_t data_len) {
@@ -116,11 +153,8 @@ void PM2005Sensor::send_command_(uint8_t cmd, const uint8_t *data, uint8_t data_
   }
   
   // Calculate checksum: 256 - (sum of all bytes except checksum)
-  uint8_t sum = 0;
-  for (uint8_t i = 0; i < idx; i++) {
-    sum += buffer[i];
-  }
-  buffer[idx++] = (256 - sum) & 0xFF;
+  buffer[idx] = pm2005_checksum(buffer, idx);
+  idx++;
   
   // Send command
   this->write_array(buffer, idx);
@@ -131,6 +165,7 @@ void PM2005Sensor::send_command_(uint8_t cmd, const uint8_t *data, uint8_t data_
 
 void PM2005Sensor::open_measurement_() {
   ESP_LOGD(TAG, "Opening measurement");
+  this->mass_requested_ = false;
   uint8_t data[] = {0x02, 0x1E};  // Open measurement
   this->send_command_(PM2005_CMD_OPEN_CLOSE, data, 2);
 }
@@ -142,6 +177,7 @@ void PM2005Sensor::read_particle_data_() {
 
 void PM2005Sensor::read_mass_data_() {
   ESP_LOGD(TAG, "Reading mass data");
+  this->mass_requested_ = true;
   uint8_t data[] = {0x01};  // Read mass data
   this->send_command_(PM2005_CMD_READ_MASS, data, 1);
 }
@@ -159,18 +195,14 @@ bool PM2005Sensor::parse_response_() {
   
   uint8_t len = this->rx_buffer_[1];
   uint8_t cmd = this->rx_buffer_[2];
-  uint8_t expected_total_len = len + 3;  // LEN + HEADER + LEN + CS
+  uint16_t expected_total_len = pm2005_frame_length(len);
   
   if (this->rx_buffer_.size() < expected_total_len) {
     return false;  // Not enough data yet
   }
   
   // Verify checksum
-  uint8_t sum = 0;
-  for (uint8_t i = 0; i < expected_total_len - 1; i++) {
-    sum += this->rx_buffer_[i];
-  }
-  uint8_t expected_cs = (256 - sum) & 0xFF;
+  uint8_t expected_cs = pm2005_checksum(this->rx_buffer_.data(), expected_total_len - 1);
   uint8_t received_cs = this->rx_buffer_[expected_total_len - 1];
   
   if (expected_cs != received_cs) {
@@ -188,27 +220,24 @@ bool PM2005Sensor::parse_response_() {
       this->measuring_ = true;
     }
     return true;
-  } else if (cmd == PM2005_CMD_READ_PARTICLE && len >= 17) {
+  } else if (cmd == PM2005_CMD_READ_PARTICLE && len >= PM2005_MIN_DATA_LEN && !this->mass_requested_) {
     // Parse particle data (PCS/L)
     // Response format: 16 11 0B DF1 DF2 DF3 DF4 DF5 DF6 DF7 DF8 DF9 DF10 DF11 DF12 DF13 DF14 DF15 DF16 [CS]
     // 0.5um: DF1-DF4, 2.5um: DF5-DF8, 10um: DF9-DF12
     
-    uint32_t pm_0_5 = (uint32_t)this->rx_buffer_[3] << 24 | 
-                      (uint32_t)this->rx_buffer_[4] << 16 | 
-                      (uint32_t)this->rx_buffer_[5] << 8 | 
-                      (uint32_t)this->rx_buffer_[6];
-    
-    uint32_t pm_2_5 = (uint32_t)this->rx_buffer_[7] << 24 | 
-                      (uint32_t)this->rx_buffer_[8] << 16 | 
-                      (uint32_t)this->rx_buffer_[9] << 8 | 
-                      (uint32_t)this->rx_buffer_[10];
-    
-    uint32_t pm_10_0 = (uint32_t)this->rx_buffer_[11] << 24 | 
-                       (uint32_t)this->rx_buffer_[12] << 16 | 
-                       (uint32_t)this->rx_buffer_[13] << 8 | 
-                       (uint32_t)this->rx_buffer_[14];
+    uint32_t pm_0_5 = pm2005_u32(&this->rx_buffer_[3]);
+    uint32_t pm_2_5 = pm2005_u32(&this->rx_buffer_[7]);
+    uint32_t pm_10_0 = pm2005_u32(&this->rx_buffer_[11]);
     
     ESP_LOGD(TAG, "PM0.5: %u PCS/L, PM2.5: %u PCS/L, PM10: %u PCS/L", pm_0_5, pm_2_5, pm_10_0);
+    this->values_[PM2005_VALUE_PM_0_5] = pm_0_5;
+    this->values_[PM2005_VALUE_PM_2_5] = pm_2_5;
+    this->values_[PM2005_VALUE_PM_10_0] = pm_10_0;
+#ifdef USE_HISTORY
+    history::record(this->pm_0_5_history_, pm_0_5);
+    history::record(this->pm_2_5_history_, pm_2_5);
+    history::record(this->pm_10_0_history_, pm_10_0);
+#endif
     
     // Publish values
     if (this->pm_0_5_sensor_ != nullptr) {
@@ -226,21 +255,27 @@ bool PM2005Sensor::parse_response_() {
     this->state_ = PM2005_STATE_DELAY_BEFORE_MASS;
     
     return true;
-  } else if (cmd == PM2005_CMD_READ_MASS && len >= 17) {
+  } else if (cmd == PM2005_CMD_READ_MASS && len >= PM2005_MIN_DATA_LEN) {
     // Parse mass data (μg/m³)
     // PM2.5: DF1-DF4, PM10: DF5-DF8
     
-    uint32_t pm_2_5_mass = (uint32_t)this->rx_buffer_[3] << 24 | 
-                           (uint32_t)this->rx_buffer_[4] << 16 | 
-                           (uint32_t)this->rx_buffer_[5] << 8 | 
-                           (uint32_t)this->rx_buffer_[6];
-    
-    uint32_t pm_10_0_mass = (uint32_t)this->rx_buffer_[7] << 24 | 
-                            (uint32_t)this->rx_buffer_[8] << 16 | 
-                            (uint32_t)this->rx_buffer_[9] << 8 | 
-                            (uint32_t)this->rx_buffer_[10];
+    uint32_t pm_2_5_mass = pm2005_u32(&this->rx_buffer_[3]);
+    uint32_t pm_10_0_mass = pm2005_u32(&this->rx_buffer_[7]);
     
     ESP_LOGD(TAG, "PM2.5 Mass: %u μg/m³, PM10 Mass: %u μg/m³", pm_2_5_mass, pm_10_0_mass);
+    this->values_[PM2005_VALUE_PM_2_5_MASS] = pm_2_5_mass;
+    this->values_[PM2005_VALUE_PM_10_0_MASS] = pm_10_0_mass;
+#ifdef USE_HISTORY
+    history::record(this->pm_2_5_mass_history_, pm_2_5_mass);
+    history::record(this->pm_10_0_mass_history_, pm_10_0_mass);
+#endif
+    
+#ifdef USE_THRESHOLD_TRIGGER
+    // Evaluate threshold triggers on the raw value first
+    for (auto *trigger : this->pm_2_5_triggers_) {
+      trigger->process(pm_2_5_mass);
+    }
+#endif
     
     // Publish values
     if (this->pm_2_5_mass_sensor_ != nullptr) {
@@ -250,7 +285,9 @@ bool PM2005Sensor::parse_response_() {
       this->pm_10_0_mass_sensor_->publish_state(pm_10_0_mass);
     }
     
-    // Done with this measurement cycle, return to idle
+    // Done with this measurement cycle, pick the next interval and return to idle
+    this->mass_requested_ = false;
+    this->update_interval_();
     this->state_ = PM2005_STATE_IDLE;
     
     return true;
@@ -259,12 +296,42 @@ bool PM2005Sensor::parse_response_() {
   return false;
 }
 
-uint8_t PM2005Sensor::calculate_checksum_(const uint8_t *data, uint8_t len) {
-  uint8_t sum = 0;
-  for (uint8_t i = 0; i < len; i++) {
-    sum += data[i];
+bool PM2005Sensor::has_changed_(uint32_t previous, uint32_t current) const {
+  uint32_t base = std::max(previous, PM2005_ADAPTIVE_MIN_BASE);
+  uint32_t delta = current > previous ? current - previous : previous - current;
+  return delta > base * this->change_threshold_;
+}
+
+void PM2005Sensor::update_interval_() {
+  if (this->adaptive_) {
+    bool changed = false;
+    if (this->has_previous_values_) {
+      for (uint8_t i = 0; i < PM2005_VALUE_COUNT; i++) {
+        if (this->has_changed_(this->previous_values_[i], this->values_[i])) {
+          changed = true;
+          break;
+        }
+      }
+    }
+
+    if (changed) {
+      // Air is changing: halve the interval down to the floor
+      this->measurement_interval_ = std::max(this->measurement_interval_ / 2, this->min_interval_);
+    } else {
+      // Air is stable: back off by a quarter up to the ceiling
+      this->measurement_interval_ =
+          std::min(this->measurement_interval_ + this->measurement_interval_ / 4, this->max_interval_);
+    }
+    ESP_LOGD(TAG, "Readings %s, next measurement in %us", changed ? "changed" : "stable",
+             this->measurement_interval_ / 1000);
+
+    memcpy(this->previous_values_, this->values_, sizeof(this->values_));
+    this->has_previous_values_ = true;
+  }
+
+  if (this->measurement_interval_sensor_ != nullptr) {
+    this->measurement_interval_sensor_->publish_state(this->measurement_interval_ / 1000.0f);
   }
-  return (256 - sum) & 0xFF;
 }
 
 }  // namespace pm2005
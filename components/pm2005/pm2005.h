@@ -1,9 +1,20 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/sensor/sensor.h"
+#ifdef USE_THRESHOLD_TRIGGER
+#include "esphome/components/threshold_trigger/threshold_trigger.h"
+#endif
+#ifdef USE_LOOP_PROFILER
+#include "esphome/components/loop_profiler/loop_profiler.h"
+#endif
 #include "esphome/components/uart/uart.h"
+#ifdef USE_HISTORY
+#include "esphome/components/history/history.h"
+#endif
+#include "pm2005_frame.h"
 
 namespace esphome {
 namespace pm2005 {
@@ -12,18 +23,7 @@ namespace pm2005 {
 // Supports UART-TTL communication (9600 baud, 8N1)
 // Protocol: Custom binary protocol for particle measurement
 
-// Protocol constants
-static const uint8_t PM2005_CMD_HEADER = 0x11;
-static const uint8_t PM2005_RESP_HEADER = 0x16;
-
-// Commands
-static const uint8_t PM2005_CMD_OPEN_CLOSE = 0x0C;
-static const uint8_t PM2005_CMD_READ_PARTICLE = 0x0B;
-static const uint8_t PM2005_CMD_READ_MASS = 0x0B;
-
-// Response lengths
-static const uint8_t PM2005_RESP_HEADER_LEN = 3;  // HEADER + LEN + CMD
-static const uint8_t PM2005_PARTICLE_DATA_LEN = 18;  // Full response length
+// Protocol constants are in pm2005_frame.h
 
 // Timing constants (in milliseconds)
 static const uint32_t PM2005_MEASUREMENT_TIME = 36000;  // 36 seconds measurement time
@@ -31,6 +31,10 @@ static const uint32_t PM2005_COMMAND_DELAY = 500;  // Delay between commands
 static const uint32_t PM2005_MEASUREMENT_INTERVAL = 60000;  // 60 seconds between measurements
 static const uint32_t PM2005_RESPONSE_TIMEOUT = 1000;  // 1 second timeout for responses
 
+// Adaptive interval: values below this are treated as this value when computing relative change,
+// so single-count jitter in clean air does not look like an event
+static const uint32_t PM2005_ADAPTIVE_MIN_BASE = 10;
+
 // Measurement states
 enum PM2005State {
   PM2005_STATE_IDLE = 0,
@@ -39,6 +43,16 @@ enum PM2005State {
   PM2005_STATE_DELAY_BEFORE_MASS = 3,
 };
 
+// Raw values decoded during one measurement cycle
+enum PM2005Value {
+  PM2005_VALUE_PM_0_5 = 0,
+  PM2005_VALUE_PM_2_5,
+  PM2005_VALUE_PM_10_0,
+  PM2005_VALUE_PM_2_5_MASS,
+  PM2005_VALUE_PM_10_0_MASS,
+  PM2005_VALUE_COUNT,
+};
+
 class PM2005Sensor : public uart::UARTDevice, public Component {
  public:
   PM2005Sensor() = default;
@@ -49,11 +63,53 @@ class PM2005Sensor : public uart::UARTDevice, public Component {
   void update();
   float get_setup_priority() const override { return setup_priority::DATA; }
 
+  // Run the measurement state machine and consume at most max_bytes of response
+  // data, returns the number of bytes consumed. Called from loop() unless a
+  // sensor_hub schedules this sensor; resume marks a second call within the same
+  // hub iteration, profiled as part of the first one.
+  size_t service(size_t max_bytes, bool resume = false);
+  void set_hub_managed(bool hub_managed) { hub_managed_ = hub_managed; }
+  uint32_t get_frame_count() const { return frame_count_; }
+  // While false, a due measurement cycle is postponed (used by sensor_hub to stagger cycles)
+  void set_start_allowed(bool start_allowed) { start_allowed_ = start_allowed; }
+  bool is_idle() const { return state_ == PM2005_STATE_IDLE; }
+
   void set_pm_0_5_sensor(sensor::Sensor *pm_0_5_sensor) { pm_0_5_sensor_ = pm_0_5_sensor; }
   void set_pm_2_5_sensor(sensor::Sensor *pm_2_5_sensor) { pm_2_5_sensor_ = pm_2_5_sensor; }
   void set_pm_10_0_sensor(sensor::Sensor *pm_10_0_sensor) { pm_10_0_sensor_ = pm_10_0_sensor; }
   void set_pm_2_5_mass_sensor(sensor::Sensor *pm_2_5_mass_sensor) { pm_2_5_mass_sensor_ = pm_2_5_mass_sensor; }
   void set_pm_10_0_mass_sensor(sensor::Sensor *pm_10_0_mass_sensor) { pm_10_0_mass_sensor_ = pm_10_0_mass_sensor; }
+  void set_measurement_interval_sensor(sensor::Sensor *measurement_interval_sensor) {
+    measurement_interval_sensor_ = measurement_interval_sensor;
+  }
+#ifdef USE_THRESHOLD_TRIGGER
+  void add_pm_2_5_trigger(threshold_trigger::ThresholdTrigger *trigger) { pm_2_5_triggers_.push_back(trigger); }
+#endif
+#ifdef USE_LOOP_PROFILER
+  void set_profiler(loop_profiler::LoopProfiler *profiler) { profiler_ = profiler; }
+#endif
+#ifdef USE_HISTORY
+  void set_pm_0_5_history(history::HistoryChannel *pm_0_5_history) { pm_0_5_history_ = pm_0_5_history; }
+  void set_pm_2_5_history(history::HistoryChannel *pm_2_5_history) { pm_2_5_history_ = pm_2_5_history; }
+  void set_pm_10_0_history(history::HistoryChannel *pm_10_0_history) { pm_10_0_history_ = pm_10_0_history; }
+  void set_pm_2_5_mass_history(history::HistoryChannel *pm_2_5_mass_history) {
+    pm_2_5_mass_history_ = pm_2_5_mass_history;
+  }
+  void set_pm_10_0_mass_history(history::HistoryChannel *pm_10_0_mass_history) {
+    pm_10_0_mass_history_ = pm_10_0_mass_history;
+  }
+#endif
+
+  // Shorten the interval towards min_interval while readings change by more than
+  // change_threshold (fraction) between cycles, relax towards max_interval otherwise.
+  // Starts at min_interval so the first reading after boot is not delayed.
+  void set_adaptive_interval(uint32_t min_interval, uint32_t max_interval, float change_threshold) {
+    this->adaptive_ = true;
+    this->min_interval_ = min_interval;
+    this->max_interval_ = max_interval;
+    this->change_threshold_ = change_threshold;
+    this->measurement_interval_ = min_interval;
+  }
 
  protected:
   void send_command_(uint8_t cmd, const uint8_t *data, uint8_t data_len);
@@ -61,19 +117,47 @@ class PM2005Sensor : public uart::UARTDevice, public Component {
   void read_particle_data_();
   void read_mass_data_();
   bool parse_response_();
-  uint8_t calculate_checksum_(const uint8_t *data, uint8_t len);
+  void update_interval_();
+  bool has_changed_(uint32_t previous, uint32_t current) const;
 
   sensor::Sensor *pm_0_5_sensor_{nullptr};
   sensor::Sensor *pm_2_5_sensor_{nullptr};
   sensor::Sensor *pm_10_0_sensor_{nullptr};
   sensor::Sensor *pm_2_5_mass_sensor_{nullptr};
   sensor::Sensor *pm_10_0_mass_sensor_{nullptr};
+  sensor::Sensor *measurement_interval_sensor_{nullptr};
+#ifdef USE_THRESHOLD_TRIGGER
+  std::vector<threshold_trigger::ThresholdTrigger *> pm_2_5_triggers_;
+#endif
+#ifdef USE_LOOP_PROFILER
+  loop_profiler::LoopProfiler *profiler_{nullptr};
+#endif
+#ifdef USE_HISTORY
+  history::HistoryChannel *pm_0_5_history_{nullptr};
+  history::HistoryChannel *pm_2_5_history_{nullptr};
+  history::HistoryChannel *pm_10_0_history_{nullptr};
+  history::HistoryChannel *pm_2_5_mass_history_{nullptr};
+  history::HistoryChannel *pm_10_0_mass_history_{nullptr};
+#endif
 
   std::vector<uint8_t> rx_buffer_;
   PM2005State state_{PM2005_STATE_IDLE};
   uint32_t last_measurement_time_{0};
   uint32_t last_command_time_{0};
   bool measuring_{false};
+  bool mass_requested_{false};
+  bool hub_managed_{false};
+  bool start_allowed_{true};
+  uint32_t frame_count_{0};
+
+  uint32_t measurement_interval_{PM2005_MEASUREMENT_INTERVAL};
+  bool adaptive_{false};
+  uint32_t min_interval_{PM2005_MEASUREMENT_INTERVAL};
+  uint32_t max_interval_{PM2005_MEASUREMENT_INTERVAL};
+  float change_threshold_{0.2f};
+  uint32_t values_[PM2005_VALUE_COUNT]{};
+  uint32_t previous_values_[PM2005_VALUE_COUNT]{};
+  bool has_previous_values_{false};
 };
 
 }  // namespace pm2005
@@ -0,0 +1,47 @@
+#pragma once
+
+// PM2005 frame definitions shared by the ESPHome component and the host-side
+// capture decoder (tools/uart_capture_decoder). Must not depend on ESPHome.
+//
+// Frame: HEADER, LEN (CMD + data bytes), CMD, data..., CS
+// CS = 256 - (sum of all previous bytes)
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace pm2005 {
+
+// Protocol constants
+static const uint8_t PM2005_CMD_HEADER = 0x11;
+static const uint8_t PM2005_RESP_HEADER = 0x16;
+
+// Commands
+static const uint8_t PM2005_CMD_OPEN_CLOSE = 0x0C;
+static const uint8_t PM2005_CMD_READ_PARTICLE = 0x0B;
+static const uint8_t PM2005_CMD_READ_MASS = 0x0B;
+
+// Response lengths
+static const uint8_t PM2005_RESP_HEADER_LEN = 3;  // HEADER + LEN + CMD
+static const uint8_t PM2005_PARTICLE_DATA_LEN = 18;  // Full response length
+static const uint8_t PM2005_MIN_DATA_LEN = 17;  // LEN of particle and mass responses
+static const uint8_t PM2005_MAX_LEN = 17;  // Largest LEN of any response
+
+// Total frame length for a given LEN byte: HEADER + LEN + (LEN bytes) + CS
+inline uint16_t pm2005_frame_length(uint8_t len) { return len + 3; }
+
+inline uint8_t pm2005_checksum(const uint8_t *data, size_t len) {
+  uint8_t sum = 0;
+  for (size_t i = 0; i < len; i++) {
+    sum += data[i];
+  }
+  return (256 - sum) & 0xFF;
+}
+
+// Data fields are big-endian 32 bit values starting at byte 3 (DF1)
+inline uint32_t pm2005_u32(const uint8_t *data) {
+  return (uint32_t) data[0] << 24 | (uint32_t) data[1] << 16 | (uint32_t) data[2] << 8 | (uint32_t) data[3];
+}
+
+}  // namespace pm2005
+}  // namespace esphome
@@ -1,3 +1,5 @@
+import importlib
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, uart
@@ -5,8 +7,10 @@ from esphome.const import (
     CONF_ID,
     CONF_PM_2_5,
     CONF_PM_10_0,
+    ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
     UNIT_MICROGRAMS_PER_CUBIC_METER,
+    UNIT_SECOND,
 )
 
 CODEOWNERS = ["@lyj0309"]
@@ -16,13 +20,77 @@ DEPENDENCIES = ["uart"]
 CONF_PM_0_5 = "pm_0_5"
 CONF_PM_2_5_MASS = "pm_2_5_mass"
 CONF_PM_10_0_MASS = "pm_10_0_mass"
+CONF_MEASUREMENT_INTERVAL = "measurement_interval"
+CONF_ADAPTIVE_INTERVAL = "adaptive_interval"
+CONF_MIN_INTERVAL = "min_interval"
+CONF_MAX_INTERVAL = "max_interval"
+CONF_CHANGE_THRESHOLD = "change_threshold"
+CONF_PROFILING = "profiling"
+CONF_HISTORY = "history"
+CONF_ON_PM25_ABOVE = "on_pm25_above"
+CONF_ON_PM25_BELOW = "on_pm25_below"
 ICON_CHEMICAL_WEAPON = "mdi:chemical-weapon"
+ICON_TIMER = "mdi:timer-outline"
 
 pm2005_ns = cg.esphome_ns.namespace("pm2005")
 PM2005Sensor = pm2005_ns.class_(
     "PM2005Sensor", uart.UARTDevice, cg.Component
 )
 
+
+# Open, 36 s measurement, particle read, 0.5 s spacing, mass read
+MEASUREMENT_CYCLE = cv.TimePeriod(seconds=37)
+# Fixed interval between cycles without adaptive_interval (PM2005_MEASUREMENT_INTERVAL)
+MEASUREMENT_INTERVAL = cv.TimePeriod(seconds=60)
+
+
+def shortest_interval(config):
+    """Shortest time between two measurement cycle starts of a pm2005 sensor config."""
+    if CONF_ADAPTIVE_INTERVAL in config:
+        return config[CONF_ADAPTIVE_INTERVAL][CONF_MIN_INTERVAL]
+    return MEASUREMENT_INTERVAL
+
+
+def validate_adaptive_interval(config):
+    if config[CONF_MIN_INTERVAL] < MEASUREMENT_CYCLE:
+        raise cv.Invalid(
+            f"{CONF_MIN_INTERVAL} must be at least {MEASUREMENT_CYCLE}, "
+            "the duration of one measurement cycle"
+        )
+    if config[CONF_MIN_INTERVAL] > config[CONF_MAX_INTERVAL]:
+        raise cv.Invalid(
+            f"{CONF_MIN_INTERVAL} must not be greater than {CONF_MAX_INTERVAL}"
+        )
+    return config
+
+
+ADAPTIVE_INTERVAL_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(
+                CONF_MIN_INTERVAL, default="60s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_MAX_INTERVAL, default="10min"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_CHANGE_THRESHOLD, default="20%"): cv.percentage,
+        }
+    ),
+    validate_adaptive_interval,
+)
+
+
+def optional_component(component, schema, *args):
+    # Optional components are only imported when their option is used, so they do
+    # not have to be listed in external_components otherwise
+    def validator(value):
+        cv.requires_component(component)(value)
+        module = importlib.import_module(f"esphome.components.{component}")
+        return getattr(module, schema)(*args)(value)
+
+    return validator
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -57,6 +125,17 @@ CONFIG_SCHEMA = cv.All(
                 accuracy_decimals=0,
                 state_class=STATE_CLASS_MEASUREMENT,
             ),
+            cv.Optional(CONF_MEASUREMENT_INTERVAL): sensor.sensor_schema(
+                unit_of_measurement=UNIT_SECOND,
+                icon=ICON_TIMER,
+                accuracy_decimals=0,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_ADAPTIVE_INTERVAL): ADAPTIVE_INTERVAL_SCHEMA,
+            cv.Optional(CONF_ON_PM25_ABOVE): optional_component("threshold_trigger", "triggers_schema", 65535),
+            cv.Optional(CONF_ON_PM25_BELOW): optional_component("threshold_trigger", "triggers_schema", 65535),
+            cv.Optional(CONF_PROFILING): optional_component("loop_profiler", "profiling_schema"),
+            cv.Optional(CONF_HISTORY): optional_component("history", "history_id"),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -88,3 +167,50 @@ async def to_code(config):
     if CONF_PM_10_0_MASS in config:
         sens = await sensor.new_sensor(config[CONF_PM_10_0_MASS])
         cg.add(var.set_pm_10_0_mass_sensor(sens))
+
+    if CONF_MEASUREMENT_INTERVAL in config:
+        sens = await sensor.new_sensor(config[CONF_MEASUREMENT_INTERVAL])
+        cg.add(var.set_measurement_interval_sensor(sens))
+
+    if CONF_ADAPTIVE_INTERVAL in config:
+        conf = config[CONF_ADAPTIVE_INTERVAL]
+        cg.add(
+            var.set_adaptive_interval(
+                conf[CONF_MIN_INTERVAL],
+                conf[CONF_MAX_INTERVAL],
+                conf[CONF_CHANGE_THRESHOLD],
+            )
+        )
+
+    if CONF_ON_PM25_ABOVE in config or CONF_ON_PM25_BELOW in config:
+        from esphome.components import threshold_trigger
+
+        await threshold_trigger.build_threshold_triggers(
+            var, config, CONF_ON_PM25_ABOVE, CONF_ON_PM25_BELOW, "add_pm_2_5_trigger"
+        )
+
+    if CONF_PROFILING in config:
+        from esphome.components import loop_profiler
+
+        profiler = await loop_profiler.new_loop_profiler(
+            config[CONF_PROFILING], "pm2005"
+        )
+        cg.add(var.set_profiler(profiler))
+
+    if CONF_HISTORY in config:
+        from esphome.components import history
+
+        # The packed 16 bit storage holds 32767 steps. Particle count steps follow
+        # the magnitude of each size class: up to 3,276,700 PCS/L for PM0.5,
+        # 327,670 PCS/L for PM2.5 and 32,767 PCS/L for PM10
+        await history.register_history_channels(
+            var,
+            config,
+            {
+                CONF_PM_0_5: (100, 1.0),
+                CONF_PM_2_5: (10, 1.0),
+                CONF_PM_10_0: (1, 1.0),
+                CONF_PM_2_5_MASS: (1, 1.0),
+                CONF_PM_10_0_MASS: (1, 1.0),
+            },
+        )
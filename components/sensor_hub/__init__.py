@@ -0,0 +1,159 @@
+import importlib
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_PERCENT,
+)
+
+CODEOWNERS = ["@lyj0309"]
+DEPENDENCIES = ["sensor"]
+
+CONF_TWO_ONE_VOC = "two_one_voc"
+CONF_JX_CO2_102 = "jx_co2_102"
+CONF_PM2005 = "pm2005"
+CONF_BYTE_BUDGET = "byte_budget"
+CONF_TIME_BUDGET = "time_budget"
+CONF_PM2005_STAGGER = "pm2005_stagger"
+CONF_BYTES_RATE = "bytes_rate"
+CONF_FRAME_RATE = "frame_rate"
+CONF_LOOP_TIME_MAX = "loop_time_max"
+CONF_BUDGET_EXHAUSTED = "budget_exhausted"
+UNIT_BYTES_PER_SECOND = "B/s"
+UNIT_FRAMES_PER_SECOND = "frames/s"
+UNIT_MICROSECOND = "µs"
+ICON_TIMER = "mdi:timer-outline"
+ICON_GAUGE = "mdi:gauge"
+
+sensor_hub_ns = cg.esphome_ns.namespace("sensor_hub")
+SensorHub = sensor_hub_ns.class_("SensorHub", cg.PollingComponent)
+
+# config key: (sensor class in <key>/sensor.py, SensorHub adder, define enabling the adder)
+DEVICES = {
+    CONF_TWO_ONE_VOC: ("FiveInOneSensor", "add_two_one_voc", "USE_SENSOR_HUB_TWO_ONE_VOC"),
+    CONF_JX_CO2_102: ("JXCO2102Sensor", "add_jx_co2_102", "USE_SENSOR_HUB_JX_CO2_102"),
+    CONF_PM2005: ("PM2005Sensor", "add_pm2005", "USE_SENSOR_HUB_PM2005"),
+}
+
+
+def _platform(key):
+    return importlib.import_module(f"esphome.components.{key}.sensor")
+
+
+def device_id(key):
+    # The sensor platform is only imported when the hub lists one of its sensors,
+    # so platforms the hub is not used with do not have to be installed
+    def validator(value):
+        return cv.use_id(getattr(_platform(key), DEVICES[key][0]))(value)
+
+    return validator
+
+
+def _diagnostic_sensor(unit, icon, accuracy_decimals):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        icon=icon,
+        accuracy_decimals=accuracy_decimals,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+def validate_devices(config):
+    if not any(config[key] for key in DEVICES):
+        raise cv.Invalid(
+            f"At least one of {', '.join(DEVICES)} must list a sensor for the hub"
+        )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(SensorHub),
+            **{
+                cv.Optional(key, default=[]): cv.ensure_list(device_id(key))
+                for key in DEVICES
+            },
+            cv.Optional(CONF_BYTE_BUDGET, default=256): cv.int_range(
+                min=32, max=4096
+            ),
+            cv.Optional(
+                CONF_TIME_BUDGET, default="2ms"
+            ): cv.positive_time_period_microseconds,
+            cv.Optional(
+                CONF_PM2005_STAGGER, default="10s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_BYTES_RATE): _diagnostic_sensor(
+                UNIT_BYTES_PER_SECOND, ICON_GAUGE, 1
+            ),
+            cv.Optional(CONF_FRAME_RATE): _diagnostic_sensor(
+                UNIT_FRAMES_PER_SECOND, ICON_GAUGE, 2
+            ),
+            cv.Optional(CONF_LOOP_TIME_MAX): _diagnostic_sensor(
+                UNIT_MICROSECOND, ICON_TIMER, 0
+            ),
+            cv.Optional(CONF_BUDGET_EXHAUSTED): _diagnostic_sensor(
+                UNIT_PERCENT, ICON_GAUGE, 1
+            ),
+        }
+    ).extend(cv.polling_component_schema("60s")),
+    validate_devices,
+)
+
+
+def final_validate_pm2005_stagger(config):
+    # The hub starts at most one PM2005 cycle per pm2005_stagger, so all sensors
+    # only get their cycle within their interval if the staggered starts fit into it
+    if not config[CONF_PM2005]:
+        return config
+    pm2005 = _platform(CONF_PM2005)
+    full_config = fv.full_config.get()
+    stagger = config[CONF_PM2005_STAGGER]
+    needed = stagger.total_milliseconds * len(config[CONF_PM2005])
+    for pm2005_id in config[CONF_PM2005]:
+        path = full_config.get_path_for_id(pm2005_id)[:-1]
+        interval = pm2005.shortest_interval(full_config.get_config_for_path(path))
+        if needed > interval.total_milliseconds:
+            raise cv.Invalid(
+                f"{len(config[CONF_PM2005])} PM2005 sensors with a {CONF_PM2005_STAGGER} of "
+                f"{stagger} need {needed / 1000:g}s per round, more than the {interval} "
+                f"measurement interval of {pm2005_id}"
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_pm2005_stagger
+
+SENSORS = {
+    CONF_BYTES_RATE: "set_bytes_rate_sensor",
+    CONF_FRAME_RATE: "set_frame_rate_sensor",
+    CONF_LOOP_TIME_MAX: "set_loop_time_max_sensor",
+    CONF_BUDGET_EXHAUSTED: "set_budget_exhausted_sensor",
+}
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_byte_budget(config[CONF_BYTE_BUDGET]))
+    cg.add(var.set_time_budget(config[CONF_TIME_BUDGET].total_microseconds))
+    cg.add(var.set_pm2005_stagger(config[CONF_PM2005_STAGGER]))
+
+    for key, (_, adder, define) in DEVICES.items():
+        if config[key]:
+            cg.add_define(define)
+        for device_id in config[key]:
+            device = await cg.get_variable(device_id)
+            cg.add(getattr(var, adder)(device))
+
+    for key, setter in SENSORS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
@@ -0,0 +1,127 @@
+#include "sensor_hub.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace sensor_hub {
+
+static const char *const TAG = "sensor_hub";
+
+#ifdef USE_SENSOR_HUB_PM2005
+size_t PM2005Device::service(SensorHub *hub, size_t max_bytes, bool resume) {
+  uint32_t now = millis();
+  bool idle = this->sensor_->is_idle();
+  if (idle) {
+    this->sensor_->set_start_allowed(hub->pm2005_slot_free(now));
+  }
+  size_t bytes = this->sensor_->service(max_bytes, resume);
+  if (idle && !this->sensor_->is_idle()) {
+    hub->pm2005_started(now);
+  }
+  return bytes;
+}
+#endif
+
+void SensorHub::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up Sensor Hub...");
+  this->last_update_ = millis();
+  this->last_frames_ = this->total_frames_();
+}
+
+void SensorHub::dump_config() {
+  ESP_LOGCONFIG(TAG, "Sensor Hub:");
+  for (auto *device : this->devices_) {
+    ESP_LOGCONFIG(TAG, "  Device: %s", device->get_type());
+  }
+  ESP_LOGCONFIG(TAG, "  Byte Budget: %u bytes per loop", this->byte_budget_);
+  ESP_LOGCONFIG(TAG, "  Time Budget: %u µs per loop", this->time_budget_);
+  ESP_LOGCONFIG(TAG, "  PM2005 Stagger: %us", this->pm2005_stagger_ / 1000);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Bytes Rate", this->bytes_rate_sensor_);
+  LOG_SENSOR("  ", "Frame Rate", this->frame_rate_sensor_);
+  LOG_SENSOR("  ", "Loop Time Max", this->loop_time_max_sensor_);
+  LOG_SENSOR("  ", "Budget Exhausted", this->budget_exhausted_sensor_);
+}
+
+void SensorHub::loop() {
+  size_t count = this->devices_.size();
+  if (count == 0) {
+    return;
+  }
+  uint32_t start = micros();
+  size_t budget = this->byte_budget_;
+  size_t quantum = std::max(budget / count, SENSOR_HUB_MIN_QUANTUM);
+
+  // First pass: an equal share for every device, in round robin order
+  size_t served = 0;
+  bool backlog = false;
+  while (served < count && budget > 0 && micros() - start < this->time_budget_) {
+    HubDevice *device = this->devices_[(this->next_ + served) % count];
+    size_t share = std::min(quantum, budget);
+    size_t bytes = device->service(this, share, false);
+    device->backlog = bytes >= share;
+    backlog |= device->backlog;
+    budget -= std::min(bytes, budget);
+    served++;
+  }
+
+  // Second pass: whatever budget is left goes to devices that filled their share.
+  // Profilers count this as part of the device's first visit.
+  for (size_t i = 0; backlog && i < served && budget > 0 && micros() - start < this->time_budget_; i++) {
+    HubDevice *device = this->devices_[(this->next_ + i) % count];
+    if (device->backlog) {
+      budget -= std::min(device->service(this, budget, true), budget);
+    }
+  }
+
+  if (served < count) {
+    // Out of budget: skipped devices go first next time
+    this->next_ = (this->next_ + served) % count;
+    this->exhausted_++;
+  } else {
+    this->next_ = (this->next_ + 1) % count;
+  }
+
+  uint32_t elapsed = micros() - start;
+  this->iterations_++;
+  this->bytes_ += this->byte_budget_ - budget;
+  this->loop_time_max_ = std::max(this->loop_time_max_, elapsed);
+}
+
+void SensorHub::update() {
+  uint32_t now = millis();
+  uint32_t frames = this->total_frames_();
+  float seconds = (now - this->last_update_) / 1000.0f;
+
+  if (seconds > 0) {
+    if (this->bytes_rate_sensor_ != nullptr) {
+      this->bytes_rate_sensor_->publish_state(this->bytes_ / seconds);
+    }
+    if (this->frame_rate_sensor_ != nullptr) {
+      this->frame_rate_sensor_->publish_state((frames - this->last_frames_) / seconds);
+    }
+  }
+  if (this->loop_time_max_sensor_ != nullptr) {
+    this->loop_time_max_sensor_->publish_state(this->loop_time_max_);
+  }
+  if (this->budget_exhausted_sensor_ != nullptr && this->iterations_ > 0) {
+    this->budget_exhausted_sensor_->publish_state(100.0f * this->exhausted_ / this->iterations_);
+  }
+
+  this->iterations_ = 0;
+  this->exhausted_ = 0;
+  this->bytes_ = 0;
+  this->loop_time_max_ = 0;
+  this->last_frames_ = frames;
+  this->last_update_ = now;
+}
+
+uint32_t SensorHub::total_frames_() const {
+  uint32_t frames = 0;
+  for (auto *device : this->devices_) {
+    frames += device->get_frame_count();
+  }
+  return frames;
+}
+
+}  // namespace sensor_hub
+}  // namespace esphome
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/sensor/sensor.h"
+#ifdef USE_SENSOR_HUB_TWO_ONE_VOC
+#include "esphome/components/two_one_voc/two_one_voc.h"
+#endif
+#ifdef USE_SENSOR_HUB_JX_CO2_102
+#include "esphome/components/jx_co2_102/jx_co2_102.h"
+#endif
+#ifdef USE_SENSOR_HUB_PM2005
+#include "esphome/components/pm2005/pm2005.h"
+#endif
+
+namespace esphome {
+namespace sensor_hub {
+
+// Smallest share of the byte budget a device gets per pass: one 21VOC packet or
+// PM2005 response frame plus some slack
+static const size_t SENSOR_HUB_MIN_QUANTUM = 24;
+
+class SensorHub;
+
+// One sensor in the hub's round robin
+class HubDevice {
+ public:
+  virtual ~HubDevice() = default;
+  // Service the sensor with at most max_bytes of input, returns the bytes consumed.
+  // resume is set for the second visit within one hub iteration.
+  virtual size_t service(SensorHub *hub, size_t max_bytes, bool resume) = 0;
+  virtual uint32_t get_frame_count() const = 0;
+  virtual const char *get_type() const = 0;
+
+  // Used its whole share in the current pass, so it may have more input pending
+  bool backlog{false};
+};
+
+// Adapter for the sensor components, which share the service() / set_hub_managed() /
+// get_frame_count() API
+template<typename T> class SensorDevice : public HubDevice {
+ public:
+  SensorDevice(T *sensor, const char *type) : sensor_(sensor), type_(type) { sensor->set_hub_managed(true); }
+
+  size_t service(SensorHub * /*hub*/, size_t max_bytes, bool resume) override {
+    return this->sensor_->service(max_bytes, resume);
+  }
+  uint32_t get_frame_count() const override { return this->sensor_->get_frame_count(); }
+  const char *get_type() const override { return this->type_; }
+
+ protected:
+  T *sensor_;
+  const char *type_;
+};
+
+#ifdef USE_SENSOR_HUB_PM2005
+// A PM2005 only starts a measurement cycle when the hub has a start slot free, so
+// the command bursts of several modules do not line up
+class PM2005Device : public SensorDevice<pm2005::PM2005Sensor> {
+ public:
+  PM2005Device(pm2005::PM2005Sensor *sensor) : SensorDevice(sensor, "PM2005") {}
+
+  size_t service(SensorHub *hub, size_t max_bytes, bool resume) override;
+};
+#endif
+
+// Services several sensor components from a single loop() under a shared budget.
+// Each iteration visits the devices round robin, giving each an equal share of
+// byte_budget; budget left over is handed to devices that still have input
+// pending. When the byte or time budget runs out, the next iteration starts with
+// the first device that was skipped.
+class SensorHub : public PollingComponent {
+ public:
+  SensorHub() = default;
+
+  void setup() override;
+  void dump_config() override;
+  void loop() override;
+  void update() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+#ifdef USE_SENSOR_HUB_TWO_ONE_VOC
+  void add_two_one_voc(two_one_voc::FiveInOneSensor *sensor) {
+    devices_.push_back(new SensorDevice<two_one_voc::FiveInOneSensor>(sensor, "21VOC"));
+  }
+#endif
+#ifdef USE_SENSOR_HUB_JX_CO2_102
+  void add_jx_co2_102(jx_co2_102::JXCO2102Sensor *sensor) {
+    devices_.push_back(new SensorDevice<jx_co2_102::JXCO2102Sensor>(sensor, "JX-CO2-102"));
+  }
+#endif
+#ifdef USE_SENSOR_HUB_PM2005
+  void add_pm2005(pm2005::PM2005Sensor *sensor) { devices_.push_back(new PM2005Device(sensor)); }
+#endif
+
+  void set_byte_budget(uint32_t byte_budget) { byte_budget_ = byte_budget; }
+  void set_time_budget(uint32_t time_budget) { time_budget_ = time_budget; }
+  void set_pm2005_stagger(uint32_t pm2005_stagger) { pm2005_stagger_ = pm2005_stagger; }
+  void set_bytes_rate_sensor(sensor::Sensor *bytes_rate_sensor) { bytes_rate_sensor_ = bytes_rate_sensor; }
+  void set_frame_rate_sensor(sensor::Sensor *frame_rate_sensor) { frame_rate_sensor_ = frame_rate_sensor; }
+  void set_loop_time_max_sensor(sensor::Sensor *loop_time_max_sensor) { loop_time_max_sensor_ = loop_time_max_sensor; }
+  void set_budget_exhausted_sensor(sensor::Sensor *budget_exhausted_sensor) {
+    budget_exhausted_sensor_ = budget_exhausted_sensor;
+  }
+
+  // PM2005 start slots: at most one measurement cycle start per pm2005_stagger
+  bool pm2005_slot_free(uint32_t now) const {
+    return !this->pm2005_started_ || now - this->last_pm2005_start_ >= this->pm2005_stagger_;
+  }
+  void pm2005_started(uint32_t now) {
+    this->pm2005_started_ = true;
+    this->last_pm2005_start_ = now;
+  }
+
+ protected:
+  uint32_t total_frames_() const;
+
+  std::vector<HubDevice *> devices_;
+  size_t next_{0};
+  uint32_t byte_budget_{256};
+  uint32_t time_budget_{2000};  // µs
+  uint32_t pm2005_stagger_{10000};
+  bool pm2005_started_{false};
+  uint32_t last_pm2005_start_{0};
+
+  sensor::Sensor *bytes_rate_sensor_{nullptr};
+  sensor::Sensor *frame_rate_sensor_{nullptr};
+  sensor::Sensor *loop_time_max_sensor_{nullptr};
+  sensor::Sensor *budget_exhausted_sensor_{nullptr};
+
+  // Statistics since the last update()
+  uint32_t iterations_{0};
+  uint32_t exhausted_{0};
+  uint64_t bytes_{0};
+  uint32_t loop_time_max_{0};
+  uint32_t last_frames_{0};
+  uint32_t last_update_{0};
+};
+
+}  // namespace sensor_hub
+}  // namespace esphome
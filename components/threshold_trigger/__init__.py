@@ -0,0 +1,63 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import automation
+from esphome.const import CONF_TRIGGER_ID
+
+CODEOWNERS = ["@lyj0309"]
+
+CONF_THRESHOLD = "threshold"
+CONF_HYSTERESIS = "hysteresis"
+CONF_MIN_HOLD = "min_hold"
+
+threshold_trigger_ns = cg.esphome_ns.namespace("threshold_trigger")
+ThresholdTrigger = threshold_trigger_ns.class_(
+    "ThresholdTrigger", automation.Trigger.template(cg.uint32)
+)
+
+
+# Enables the on_<value>_above/below options of the sensor components
+CONFIG_SCHEMA = cv.Schema({})
+
+
+async def to_code(config):
+    cg.add_define("USE_THRESHOLD_TRIGGER")
+
+
+def validate_hysteresis(config):
+    # An above trigger re-arms below threshold - hysteresis, which a raw reading
+    # could never reach otherwise
+    if config[CONF_HYSTERESIS] >= config[CONF_THRESHOLD]:
+        raise cv.Invalid(f"{CONF_HYSTERESIS} must be smaller than {CONF_THRESHOLD}")
+    return config
+
+
+def triggers_schema(max_value):
+    """Schema for a list of on_<value>_above/below triggers on raw values up to max_value."""
+    return automation.validate_automation(
+        {
+            cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ThresholdTrigger),
+            cv.Required(CONF_THRESHOLD): cv.int_range(min=0, max=max_value),
+            cv.Optional(CONF_HYSTERESIS, default=0): cv.int_range(
+                min=0, max=max_value
+            ),
+            cv.Optional(
+                CONF_MIN_HOLD, default="0s"
+            ): cv.positive_time_period_milliseconds,
+        },
+        extra_validators=validate_hysteresis,
+    )
+
+
+async def build_threshold_triggers(var, config, above_key, below_key, adder):
+    """Create the triggers listed under above_key/below_key and register them with var.adder()."""
+    for key, above in ((above_key, True), (below_key, False)):
+        for conf in config.get(key, []):
+            trigger = cg.new_Pvariable(
+                conf[CONF_TRIGGER_ID],
+                above,
+                conf[CONF_THRESHOLD],
+                conf[CONF_HYSTERESIS],
+                conf[CONF_MIN_HOLD],
+            )
+            cg.add(getattr(var, adder)(trigger))
+            await automation.build_automation(trigger, [(cg.uint32, "x")], conf)
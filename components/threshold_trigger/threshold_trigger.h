@@ -0,0 +1,58 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace threshold_trigger {
+
+// Threshold trigger evaluated by the sensor components on the raw value of every
+// decoded frame, before any float conversion or filter chain. "above" triggers fire
+// when the value rises over the threshold and re-arm once it falls below
+// threshold - hysteresis; "below" triggers are the mirror image. Each state is
+// held for at least min_hold ms.
+class ThresholdTrigger : public Trigger<uint32_t> {
+ public:
+  ThresholdTrigger(bool above, uint32_t threshold, uint32_t hysteresis, uint32_t min_hold)
+      : above_(above), threshold_(threshold), hysteresis_(hysteresis), min_hold_(min_hold) {}
+
+  void process(uint32_t value) {
+    uint32_t now = millis();
+    if (this->has_changed_ && now - this->last_change_ < this->min_hold_) {
+      return;
+    }
+
+    bool crossed;
+    bool released;
+    if (this->above_) {
+      crossed = value > this->threshold_;
+      released = this->hysteresis_ < this->threshold_ && value < this->threshold_ - this->hysteresis_;
+    } else {
+      crossed = value < this->threshold_;
+      released = this->hysteresis_ <= UINT32_MAX - this->threshold_ && value > this->threshold_ + this->hysteresis_;
+    }
+
+    if (!this->active_ && crossed) {
+      this->active_ = true;
+      this->has_changed_ = true;
+      this->last_change_ = now;
+      this->trigger(value);
+    } else if (this->active_ && released) {
+      this->active_ = false;
+      this->has_changed_ = true;
+      this->last_change_ = now;
+    }
+  }
+
+ protected:
+  bool above_;
+  uint32_t threshold_;
+  uint32_t hysteresis_;
+  uint32_t min_hold_;
+  bool active_{false};
+  bool has_changed_{false};
+  uint32_t last_change_{0};
+};
+
+}  // namespace threshold_trigger
+}  // namespace esphome
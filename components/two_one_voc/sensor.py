@@ -1,3 +1,5 @@
+import importlib
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, uart
@@ -22,6 +24,10 @@ DEPENDENCIES = ["uart"]
 # Define custom constants
 CONF_VOC = "voc"
 CONF_ECO2 = "eco2"
+CONF_PROFILING = "profiling"
+CONF_HISTORY = "history"
+CONF_ON_VOC_ABOVE = "on_voc_above"
+CONF_ON_VOC_BELOW = "on_voc_below"
 ICON_MOLECULE_CO2 = "mdi:molecule-co2"
 ICON_CHEMICAL_WEAPON = "mdi:chemical-weapon"
 
@@ -30,6 +36,18 @@ FiveInOneSensor = two_one_voc_ns.class_(
     "FiveInOneSensor", uart.UARTDevice, cg.Component
 )
 
+
+def optional_component(component, schema, *args):
+    # Optional components are only imported when their option is used, so they do
+    # not have to be listed in external_components otherwise
+    def validator(value):
+        cv.requires_component(component)(value)
+        module = importlib.import_module(f"esphome.components.{component}")
+        return getattr(module, schema)(*args)(value)
+
+    return validator
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -64,6 +82,10 @@ CONFIG_SCHEMA = cv.All(
                 device_class=DEVICE_CLASS_HUMIDITY,
                 state_class=STATE_CLASS_MEASUREMENT,
             ),
+            cv.Optional(CONF_ON_VOC_ABOVE): optional_component("threshold_trigger", "triggers_schema", 65535),
+            cv.Optional(CONF_ON_VOC_BELOW): optional_component("threshold_trigger", "triggers_schema", 65535),
+            cv.Optional(CONF_PROFILING): optional_component("loop_profiler", "profiling_schema"),
+            cv.Optional(CONF_HISTORY): optional_component("history", "history_id"),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -95,3 +117,34 @@ async def to_code(config):
     if CONF_HUMIDITY in config:
         sens = await sensor.new_sensor(config[CONF_HUMIDITY])
         cg.add(var.set_humidity_sensor(sens))
+
+    if CONF_ON_VOC_ABOVE in config or CONF_ON_VOC_BELOW in config:
+        from esphome.components import threshold_trigger
+
+        await threshold_trigger.build_threshold_triggers(
+            var, config, CONF_ON_VOC_ABOVE, CONF_ON_VOC_BELOW, "add_voc_trigger"
+        )
+
+    if CONF_PROFILING in config:
+        from esphome.components import loop_profiler
+
+        profiler = await loop_profiler.new_loop_profiler(
+            config[CONF_PROFILING], "two_one_voc"
+        )
+        cg.add(var.set_profiler(profiler))
+
+    if CONF_HISTORY in config:
+        from esphome.components import history
+
+        # Raw units: µg/m³, ppm, 0.1 °C and 0.1 %RH
+        await history.register_history_channels(
+            var,
+            config,
+            {
+                CONF_VOC: (1, 1.0),
+                CONF_FORMALDEHYDE: (1, 1.0),
+                CONF_ECO2: (1, 1.0),
+                CONF_TEMPERATURE: (1, 0.1),
+                CONF_HUMIDITY: (1, 0.1),
+            },
+        )
@@ -21,10 +21,23 @@ void FiveInOneSensor::dump_config() {
 }
 
 void FiveInOneSensor::loop() {
+  if (this->hub_managed_) {
+    return;
+  }
+  this->service(SIZE_MAX);
+}
+
+size_t FiveInOneSensor::service(size_t max_bytes, bool resume) {
+#ifdef USE_LOOP_PROFILER
+  uint32_t loop_start = this->profiler_ != nullptr ? loop_profiler::LoopProfiler::begin() : 0;
+#endif
+  size_t bytes_read = 0;
+  
   // Read available data from UART
-  while (this->available()) {
+  while (bytes_read < max_bytes && this->available()) {
     uint8_t byte;
     this->read_byte(&byte);
+    bytes_read++;
     
     // If we find the header byte, start a new packet
     if (byte == HEADER_BYTE && this->rx_buffer_.empty()) {
@@ -34,7 +47,17 @@ void FiveInOneSensor::loop() {
       
       // If we have a complete packet, parse it
       if (this->rx_buffer_.size() == PACKET_SIZE) {
-        if (this->parse_data_()) {
+#ifdef USE_LOOP_PROFILER
+        uint32_t parse_start = this->profiler_ != nullptr ? loop_profiler::LoopProfiler::begin() : 0;
+#endif
+        bool parsed = this->parse_data_();
+#ifdef USE_LOOP_PROFILER
+        if (this->profiler_ != nullptr) {
+          this->profiler_->record_parse(parse_start);
+        }
+#endif
+        if (parsed) {
+          this->frame_count_++;
           ESP_LOGV(TAG, "Successfully parsed data packet");
         } else {
           ESP_LOGW(TAG, "Invalid data packet received");
@@ -49,15 +72,17 @@ void FiveInOneSensor::loop() {
     ESP_LOGW(TAG, "Buffer overflow, clearing");
     this->rx_buffer_.clear();
   }
+  
+#ifdef USE_LOOP_PROFILER
+  if (this->profiler_ != nullptr) {
+    this->profiler_->record_loop(loop_start, bytes_read, resume);
+  }
+#endif
+  return bytes_read;
 }
 
 bool FiveInOneSensor::validate_checksum_(const uint8_t *data) {
-  // Checksum = sum of first 11 bytes inverted + 1
-  uint8_t sum = 0;
-  for (int i = 0; i < 11; i++) {
-    sum += data[i];
-  }
-  uint8_t expected_checksum = (~sum) + 1;
+  uint8_t expected_checksum = frame_checksum(data);
   
   if (data[11] != expected_checksum) {
     ESP_LOGW(TAG, "Checksum failed: expected 0x%02X, got 0x%02X", expected_checksum, data[11]);
@@ -67,13 +92,7 @@ bool FiveInOneSensor::validate_checksum_(const uint8_t *data) {
 }
 
 int16_t FiveInOneSensor::parse_temperature_(uint16_t raw_value) {
-  // Check if temperature is negative (MSB is 1)
-  if (raw_value & 0x8000) {
-    // Negative temperature: -(0xFFFF - raw_value)
-    // Example: -10°C = 0xFFF5, 0xFFFF - 0xFFF5 = 0x000A = 10, then negate = -10
-    return -static_cast<int16_t>(0xFFFF - raw_value);
-  }
-  return static_cast<int16_t>(raw_value);
+  return decode_temperature(raw_value);
 }
 
 bool FiveInOneSensor::parse_data_() {
@@ -95,21 +114,27 @@ bool FiveInOneSensor::parse_data_() {
   }
   
   // Parse VOC (bytes 1-2): Data[1]*256 + Data[2]
-  uint16_t voc = (data[1] << 8) | data[2];
+  uint16_t voc = frame_u16(data, VOC_INDEX);
+#ifdef USE_THRESHOLD_TRIGGER
+  // Evaluate threshold triggers on the raw value first
+  for (auto *trigger : this->voc_triggers_) {
+    trigger->process(voc);
+  }
+#endif
   if (this->voc_sensor_ != nullptr) {
     this->voc_sensor_->publish_state(voc);
   }
   ESP_LOGD(TAG, "VOC: %d µg/m³", voc);
   
   // Parse Formaldehyde (bytes 3-4): Data[3]*256 + Data[4]
-  uint16_t formaldehyde = (data[3] << 8) | data[4];
+  uint16_t formaldehyde = frame_u16(data, FORMALDEHYDE_INDEX);
   if (this->formaldehyde_sensor_ != nullptr) {
     this->formaldehyde_sensor_->publish_state(formaldehyde);
   }
   ESP_LOGD(TAG, "Formaldehyde: %d µg/m³", formaldehyde);
   
   // Parse eCO2 (bytes 5-6): Data[5]*256 + Data[6]
-  uint16_t eco2 = (data[5] << 8) | data[6];
+  uint16_t eco2 = frame_u16(data, ECO2_INDEX);
   if (this->eco2_sensor_ != nullptr) {
     this->eco2_sensor_->publish_state(eco2);
   }
@@ -117,7 +142,7 @@ bool FiveInOneSensor::parse_data_() {
   
   // Parse Temperature (bytes 7-8): Data[7]*256 + Data[8]
   // Unit is 0.1°C, with special handling for negative values
-  uint16_t temp_raw = (data[7] << 8) | data[8];
+  uint16_t temp_raw = frame_u16(data, TEMPERATURE_INDEX);
   int16_t temp_value = this->parse_temperature_(temp_raw);
   float temperature = temp_value * 0.1f;
   if (this->temperature_sensor_ != nullptr) {
@@ -127,13 +152,22 @@ bool FiveInOneSensor::parse_data_() {
   
   // Parse Humidity (bytes 9-10): Data[9]*256 + Data[10]
   // Unit is 0.1%RH
-  uint16_t humidity_raw = (data[9] << 8) | data[10];
+  uint16_t humidity_raw = frame_u16(data, HUMIDITY_INDEX);
   float humidity = humidity_raw * 0.1f;
   if (this->humidity_sensor_ != nullptr) {
     this->humidity_sensor_->publish_state(humidity);
   }
   ESP_LOGD(TAG, "Humidity: %.1f %%", humidity);
   
+#ifdef USE_HISTORY
+  // Record the raw values, temperature and humidity in 0.1 units
+  history::record(this->voc_history_, voc);
+  history::record(this->formaldehyde_history_, formaldehyde);
+  history::record(this->eco2_history_, eco2);
+  history::record(this->temperature_history_, temp_value);
+  history::record(this->humidity_history_, humidity_raw);
+#endif
+  
   return true;
 }
 
@@ -1,16 +1,24 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/sensor/sensor.h"
+#ifdef USE_THRESHOLD_TRIGGER
+#include "esphome/components/threshold_trigger/threshold_trigger.h"
+#endif
+#ifdef USE_LOOP_PROFILER
+#include "esphome/components/loop_profiler/loop_profiler.h"
+#endif
+#ifdef USE_HISTORY
+#include "esphome/components/history/history.h"
+#endif
 #include "esphome/components/uart/uart.h"
+#include "two_one_voc_frame.h"
 
 namespace esphome {
 namespace two_one_voc {
 
-static const uint8_t PACKET_SIZE = 12;
-static const uint8_t HEADER_BYTE = 0x2C;
-
 class FiveInOneSensor : public uart::UARTDevice, public Component {
  public:
   FiveInOneSensor() = default;
@@ -20,6 +28,13 @@ class FiveInOneSensor : public uart::UARTDevice, public Component {
   void loop() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
+  // Drain at most max_bytes of UART input, returns the number of bytes consumed.
+  // Called from loop() unless a sensor_hub schedules this sensor; resume marks a
+  // second call within the same hub iteration, profiled as part of the first one.
+  size_t service(size_t max_bytes, bool resume = false);
+  void set_hub_managed(bool hub_managed) { hub_managed_ = hub_managed; }
+  uint32_t get_frame_count() const { return frame_count_; }
+
   void set_voc_sensor(sensor::Sensor *voc_sensor) { voc_sensor_ = voc_sensor; }
   void set_formaldehyde_sensor(sensor::Sensor *formaldehyde_sensor) { 
     formaldehyde_sensor_ = formaldehyde_sensor; 
@@ -31,6 +46,23 @@ class FiveInOneSensor : public uart::UARTDevice, public Component {
   void set_humidity_sensor(sensor::Sensor *humidity_sensor) { 
     humidity_sensor_ = humidity_sensor; 
   }
+#ifdef USE_THRESHOLD_TRIGGER
+  void add_voc_trigger(threshold_trigger::ThresholdTrigger *trigger) { voc_triggers_.push_back(trigger); }
+#endif
+#ifdef USE_LOOP_PROFILER
+  void set_profiler(loop_profiler::LoopProfiler *profiler) { profiler_ = profiler; }
+#endif
+#ifdef USE_HISTORY
+  void set_voc_history(history::HistoryChannel *voc_history) { voc_history_ = voc_history; }
+  void set_formaldehyde_history(history::HistoryChannel *formaldehyde_history) {
+    formaldehyde_history_ = formaldehyde_history;
+  }
+  void set_eco2_history(history::HistoryChannel *eco2_history) { eco2_history_ = eco2_history; }
+  void set_temperature_history(history::HistoryChannel *temperature_history) {
+    temperature_history_ = temperature_history;
+  }
+  void set_humidity_history(history::HistoryChannel *humidity_history) { humidity_history_ = humidity_history; }
+#endif
 
  protected:
   bool parse_data_();
@@ -42,8 +74,23 @@ class FiveInOneSensor : public uart::UARTDevice, public Component {
   sensor::Sensor *eco2_sensor_{nullptr};
   sensor::Sensor *temperature_sensor_{nullptr};
   sensor::Sensor *humidity_sensor_{nullptr};
+#ifdef USE_THRESHOLD_TRIGGER
+  std::vector<threshold_trigger::ThresholdTrigger *> voc_triggers_;
+#endif
+#ifdef USE_LOOP_PROFILER
+  loop_profiler::LoopProfiler *profiler_{nullptr};
+#endif
+#ifdef USE_HISTORY
+  history::HistoryChannel *voc_history_{nullptr};
+  history::HistoryChannel *formaldehyde_history_{nullptr};
+  history::HistoryChannel *eco2_history_{nullptr};
+  history::HistoryChannel *temperature_history_{nullptr};
+  history::HistoryChannel *humidity_history_{nullptr};
+#endif
 
   std::vector<uint8_t> rx_buffer_;
+  bool hub_managed_{false};
+  uint32_t frame_count_{0};
 };
 
 }  // namespace two_one_voc
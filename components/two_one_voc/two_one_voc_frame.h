@@ -0,0 +1,44 @@
+#pragma once
+
+// 21VOC frame definitions shared by the ESPHome component and the host-side
+// capture decoder (tools/uart_capture_decoder). Must not depend on ESPHome.
+
+#include <cstdint>
+
+namespace esphome {
+namespace two_one_voc {
+
+static const uint8_t PACKET_SIZE = 12;
+static const uint8_t HEADER_BYTE = 0x2C;
+
+// Checksum = sum of first 11 bytes inverted + 1
+inline uint8_t frame_checksum(const uint8_t *data) {
+  uint8_t sum = 0;
+  for (int i = 0; i < 11; i++) {
+    sum += data[i];
+  }
+  return (~sum) + 1;
+}
+
+inline bool frame_checksum_valid(const uint8_t *data) { return data[11] == frame_checksum(data); }
+
+inline uint16_t frame_u16(const uint8_t *data, uint8_t index) { return (data[index] << 8) | data[index + 1]; }
+
+// Temperature is negative when the MSB is 1: -(0xFFFF - raw_value)
+// Example: -10°C = 0xFFF5, 0xFFFF - 0xFFF5 = 0x000A = 10, then negate = -10
+inline int16_t decode_temperature(uint16_t raw_value) {
+  if (raw_value & 0x8000) {
+    return -static_cast<int16_t>(0xFFFF - raw_value);
+  }
+  return static_cast<int16_t>(raw_value);
+}
+
+// Field offsets (big-endian 16 bit values)
+static const uint8_t VOC_INDEX = 1;
+static const uint8_t FORMALDEHYDE_INDEX = 3;
+static const uint8_t ECO2_INDEX = 5;
+static const uint8_t TEMPERATURE_INDEX = 7;  // 0.1 °C
+static const uint8_t HUMIDITY_INDEX = 9;     // 0.1 %RH
+
+}  // namespace two_one_voc
+}  // namespace esphome
@@ -0,0 +1,243 @@
+#include "decoder.h"
+
+#include <cstring>
+#include <thread>
+
+#include "jx_co2_102/jx_co2_102_frame.h"
+#include "pm2005/pm2005_frame.h"
+#include "two_one_voc/two_one_voc_frame.h"
+
+namespace uart_capture {
+
+namespace voc = esphome::two_one_voc;
+namespace co2 = esphome::jx_co2_102;
+namespace pm = esphome::pm2005;
+
+bool parse_sensor_type(const std::string &name, SensorType *type) {
+  if (name == "voc" || name == "two_one_voc") {
+    *type = SensorType::VOC;
+  } else if (name == "co2" || name == "jx_co2_102") {
+    *type = SensorType::CO2;
+  } else if (name == "pm2005") {
+    *type = SensorType::PM2005;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const std::vector<const char *> &column_names(SensorType type) {
+  static const std::vector<const char *> VOC_COLUMNS = {"voc", "formaldehyde", "eco2", "temperature_x10",
+                                                        "humidity_x10"};
+  static const std::vector<const char *> CO2_COLUMNS = {"co2"};
+  // df1..df3 are PM0.5/PM2.5/PM10 counts for particle frames and PM2.5/PM10 mass for mass frames
+  static const std::vector<const char *> PM2005_COLUMNS = {"cmd", "kind", "df1", "df2", "df3"};
+  switch (type) {
+    case SensorType::VOC:
+      return VOC_COLUMNS;
+    case SensorType::CO2:
+      return CO2_COLUMNS;
+    default:
+      return PM2005_COLUMNS;
+  }
+}
+
+// Header scanning uses memchr, which libc implements with SIMD on all common
+// hosts, so the scan between frames runs at memory bandwidth.
+static const uint8_t *find_byte(const uint8_t *from, const uint8_t *to, uint8_t value) {
+  return static_cast<const uint8_t *>(memchr(from, value, to - from));
+}
+
+static void decode_voc(const uint8_t *data, size_t size, size_t begin, size_t end, std::vector<Record> *out) {
+  const uint8_t *const base = data;
+  const uint8_t *p = data + begin;
+  const uint8_t *const stop = data + end;
+  const uint8_t *const last = data + size;
+  while (p < stop) {
+    p = find_byte(p, stop, voc::HEADER_BYTE);
+    if (p == nullptr || last - p < voc::PACKET_SIZE) {
+      return;
+    }
+    if (!voc::frame_checksum_valid(p)) {
+      p++;
+      continue;
+    }
+    Record record;
+    record.offset = p - base;
+    record.length = voc::PACKET_SIZE;
+    record.values[0] = voc::frame_u16(p, voc::VOC_INDEX);
+    record.values[1] = voc::frame_u16(p, voc::FORMALDEHYDE_INDEX);
+    record.values[2] = voc::frame_u16(p, voc::ECO2_INDEX);
+    record.values[3] = voc::decode_temperature(voc::frame_u16(p, voc::TEMPERATURE_INDEX));
+    record.values[4] = voc::frame_u16(p, voc::HUMIDITY_INDEX);
+    out->push_back(record);
+    p += voc::PACKET_SIZE;
+  }
+}
+
+static void decode_co2(const uint8_t *data, size_t size, size_t begin, size_t end, std::vector<Record> *out) {
+  (void) size;  // Lines end inside the chunk, nothing is read past end
+  const uint8_t *p = data + begin;
+  const uint8_t *const stop = data + end;
+
+  // Start of the first line: just after the previous terminator
+  const uint8_t *line = p;
+  while (line > data && line[-1] != co2::LINE_TERMINATOR && p - line <= co2::MAX_LINE_LENGTH) {
+    line--;
+  }
+
+  char number[co2::MAX_LINE_LENGTH + 1];
+  while (p < stop) {
+    const uint8_t *nl = find_byte(p, stop, co2::LINE_TERMINATOR);
+    if (nl == nullptr) {
+      return;
+    }
+    size_t len = nl + 1 - line;
+    long ppm;
+    if (len <= co2::MAX_LINE_LENGTH && co2::parse_line(line, len, &ppm, number) == co2::LINE_OK) {
+      Record record;
+      record.offset = line - data;
+      record.length = len;
+      record.values[0] = ppm;
+      out->push_back(record);
+    }
+    line = p = nl + 1;
+  }
+}
+
+static void decode_pm2005(const uint8_t *data, size_t size, size_t begin, size_t end, std::vector<Record> *out) {
+  const uint8_t *p = data + begin;
+  const uint8_t *const stop = data + end;
+  const uint8_t *const last = data + size;
+  while (p < stop) {
+    p = find_byte(p, stop, pm::PM2005_RESP_HEADER);
+    if (p == nullptr || last - p < pm::PM2005_RESP_HEADER_LEN) {
+      return;
+    }
+    // No response is longer than PM2005_MAX_LEN, rejecting longer ones keeps a false
+    // header from swallowing the frames that follow it
+    uint16_t total = pm::pm2005_frame_length(p[1]);
+    if (p[1] > pm::PM2005_MAX_LEN || last - p < total || pm::pm2005_checksum(p, total - 1) != p[total - 1]) {
+      p++;
+      continue;
+    }
+    Record record;
+    record.offset = p - data;
+    record.length = total;
+    uint8_t cmd = p[2];
+    record.values[0] = cmd;
+    record.values[1] = cmd == pm::PM2005_CMD_OPEN_CLOSE ? PM2005_KIND_OPEN : PM2005_KIND_UNKNOWN;
+    if (cmd == pm::PM2005_CMD_READ_PARTICLE && p[1] >= pm::PM2005_MIN_DATA_LEN) {
+      record.values[2] = pm::pm2005_u32(p + 3);
+      record.values[3] = pm::pm2005_u32(p + 7);
+      record.values[4] = pm::pm2005_u32(p + 11);
+    } else {
+      record.values[2] = record.values[3] = record.values[4] = 0;
+    }
+    out->push_back(record);
+    p += total;
+  }
+}
+
+void decode_chunk(SensorType type, const uint8_t *data, size_t size, size_t begin, size_t end,
+                  std::vector<Record> *out) {
+  switch (type) {
+    case SensorType::VOC:
+      decode_voc(data, size, begin, end, out);
+      break;
+    case SensorType::CO2:
+      decode_co2(data, size, begin, end, out);
+      break;
+    case SensorType::PM2005:
+      decode_pm2005(data, size, begin, end, out);
+      break;
+  }
+}
+
+// Particle and mass responses share command 0x0B: after an open response the
+// first one is particle data and the second one mass data.
+static void classify_pm2005(std::vector<std::vector<Record>> *chunks) {
+  int since_open = -1;
+  for (auto &chunk : *chunks) {
+    for (Record &record : chunk) {
+      if (record.values[1] == PM2005_KIND_OPEN) {
+        since_open = 0;
+      } else if (record.values[0] == pm::PM2005_CMD_READ_PARTICLE && since_open >= 0 && since_open < 2) {
+        record.values[1] = since_open == 0 ? PM2005_KIND_PARTICLE : PM2005_KIND_MASS;
+        since_open++;
+      }
+    }
+  }
+}
+
+std::vector<std::vector<Record>> decode_parallel(SensorType type, const uint8_t *data, size_t size,
+                                                 unsigned threads) {
+  if (threads == 0) {
+    threads = 1;
+  }
+  size_t chunk_size = (size + threads - 1) / threads;
+  std::vector<std::vector<Record>> chunks(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (unsigned i = 0; i < threads; i++) {
+    size_t begin = std::min(size, i * chunk_size);
+    size_t end = std::min(size, begin + chunk_size);
+    auto *out = &chunks[i];
+    out->reserve((end - begin) / 12);
+    if (threads == 1) {
+      decode_chunk(type, data, size, begin, end, out);
+    } else {
+      workers.emplace_back([=]() { decode_chunk(type, data, size, begin, end, out); });
+    }
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  // A frame that started in the previous chunk may extend into this one, and the
+  // worker of this chunk may have synchronised on a header byte inside it and
+  // skipped real frames behind that false one. Such records are dropped and the
+  // bytes after the previous frame are decoded again up to the next kept record,
+  // until the rescan ends at or before it; from there the worker's scan is the
+  // same as a single-threaded one.
+  uint64_t covered = 0;
+  for (unsigned i = 0; i < threads; i++) {
+    std::vector<Record> &chunk = chunks[i];
+    size_t chunk_end = std::min(size, (i + 1) * chunk_size);
+    std::vector<Record> rescanned;
+    size_t kept = 0;
+    while (kept < chunk.size() && chunk[kept].offset < covered) {
+      while (kept < chunk.size() && chunk[kept].offset < covered) {
+        kept++;
+      }
+      size_t next = kept < chunk.size() ? chunk[kept].offset : chunk_end;
+      size_t found = rescanned.size();
+      decode_chunk(type, data, size, covered, next, &rescanned);
+      if (rescanned.size() > found) {
+        covered = rescanned.back().offset + rescanned.back().length;
+      }
+    }
+    if (kept > 0) {
+      rescanned.insert(rescanned.end(), chunk.begin() + kept, chunk.end());
+      chunk.swap(rescanned);
+    }
+    if (!chunk.empty()) {
+      covered = chunk.back().offset + chunk.back().length;
+    }
+  }
+
+  if (type == SensorType::PM2005) {
+    classify_pm2005(&chunks);
+  }
+  return chunks;
+}
+
+size_t count_records(const std::vector<std::vector<Record>> &chunks) {
+  size_t count = 0;
+  for (const auto &chunk : chunks) {
+    count += chunk.size();
+  }
+  return count;
+}
+
+}  // namespace uart_capture
@@ -0,0 +1,50 @@
+#pragma once
+
+// Chunked frame decoders for raw UART captures, built on the frame definitions
+// of the ESPHome components (components/*/..._frame.h).
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uart_capture {
+
+enum class SensorType { VOC, CO2, PM2005 };
+
+static const size_t MAX_COLUMNS = 5;
+
+// One decoded frame. values[] holds the sensor specific columns, see column_names().
+struct Record {
+  uint64_t offset;  // Byte offset of the frame in the capture
+  uint32_t length;  // Frame length in bytes
+  int64_t values[MAX_COLUMNS];
+};
+
+// PM2005 frame kinds (pm2005 "kind" column)
+enum PM2005Kind : int64_t {
+  PM2005_KIND_OPEN = 0,
+  PM2005_KIND_PARTICLE = 1,
+  PM2005_KIND_MASS = 2,
+  PM2005_KIND_UNKNOWN = 3,
+};
+
+bool parse_sensor_type(const std::string &name, SensorType *type);
+const std::vector<const char *> &column_names(SensorType type);
+
+// Decode all frames that start (VOC, PM2005) or end (CO2 lines) inside
+// [begin, end) of data[0, size). Frames may extend past end; bytes before
+// begin are only looked at to find the start of a CO2 line.
+void decode_chunk(SensorType type, const uint8_t *data, size_t size, size_t begin, size_t end,
+                  std::vector<Record> *out);
+
+// Decode a whole capture with the given number of threads. Chunk results are
+// stitched so that the records are the same as with one thread, and
+// PM2005 particle/mass responses are told apart by their order after an open
+// response (both use command 0x0B).
+std::vector<std::vector<Record>> decode_parallel(SensorType type, const uint8_t *data, size_t size,
+                                                 unsigned threads);
+
+size_t count_records(const std::vector<std::vector<Record>> &chunks);
+
+}  // namespace uart_capture
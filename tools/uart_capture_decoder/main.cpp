@@ -0,0 +1,426 @@
+// Offline decoder for raw UART captures of the 21VOC, JX-CO2-102 and PM2005
+// sensors. See README.md in this directory for usage.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "decoder.h"
+#include "jx_co2_102/jx_co2_102_frame.h"
+#include "pm2005/pm2005_frame.h"
+#include "two_one_voc/two_one_voc_frame.h"
+
+using namespace uart_capture;
+
+namespace {
+
+const char BINARY_MAGIC[8] = {'U', 'C', 'A', 'P', 'C', 'O', 'L', '1'};
+const uint8_t COLUMN_U64 = 1;
+const uint8_t COLUMN_I64 = 2;
+
+struct Options {
+  std::string command;
+  std::string input;
+  std::string output;
+  std::string format{"csv"};
+  SensorType type{SensorType::VOC};
+  bool has_type{false};
+  unsigned threads{0};
+  unsigned repeat{3};
+  size_t synthetic_size{0};
+};
+
+void usage() {
+  fprintf(stderr,
+          "Usage:\n"
+          "  uart_capture_decoder decode --type <voc|co2|pm2005> [--threads N] [--format csv|bin] [-o out] <capture>\n"
+          "  uart_capture_decoder bench --type <voc|co2|pm2005> [--threads N] [--repeat N]\n"
+          "                             (<capture> | --synthetic <size>)\n"
+          "  uart_capture_decoder generate --type <voc|co2|pm2005> --size <size> -o <capture>\n"
+          "Sizes accept K, M and G suffixes. --threads defaults to the number of cores.\n");
+}
+
+bool parse_size(const char *text, size_t *size) {
+  char *end;
+  double value = strtod(text, &end);
+  switch (*end) {
+    case 'G':
+    case 'g':
+      value *= 1024.0;
+      // fallthrough
+    case 'M':
+    case 'm':
+      value *= 1024.0;
+      // fallthrough
+    case 'K':
+    case 'k':
+      value *= 1024.0;
+      end++;
+      break;
+    default:
+      break;
+  }
+  if (end == text || *end != '\0' || value <= 0) {
+    return false;
+  }
+  *size = static_cast<size_t>(value);
+  return true;
+}
+
+bool parse_options(int argc, char **argv, Options *options) {
+  if (argc < 2) {
+    return false;
+  }
+  options->command = argv[1];
+  for (int i = 2; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--type" && has_value) {
+      if (!parse_sensor_type(argv[++i], &options->type)) {
+        fprintf(stderr, "Unknown sensor type '%s'\n", argv[i]);
+        return false;
+      }
+      options->has_type = true;
+    } else if (arg == "--threads" && has_value) {
+      options->threads = atoi(argv[++i]);
+    } else if (arg == "--repeat" && has_value) {
+      options->repeat = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--format" && has_value) {
+      options->format = argv[++i];
+    } else if ((arg == "-o" || arg == "--output") && has_value) {
+      options->output = argv[++i];
+    } else if ((arg == "--synthetic" || arg == "--size") && has_value) {
+      if (!parse_size(argv[++i], &options->synthetic_size)) {
+        fprintf(stderr, "Invalid size '%s'\n", argv[i]);
+        return false;
+      }
+    } else if (!arg.empty() && arg[0] != '-' && options->input.empty()) {
+      options->input = arg;
+    } else {
+      fprintf(stderr, "Unexpected argument '%s'\n", arg.c_str());
+      return false;
+    }
+  }
+  if (options->threads == 0) {
+    options->threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return options->has_type;
+}
+
+// Read-only memory mapping of a capture file
+class MappedFile {
+ public:
+  ~MappedFile() {
+    if (this->data_ != nullptr) {
+      munmap(const_cast<uint8_t *>(this->data_), this->size_);
+    }
+  }
+
+  bool open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      perror(path.c_str());
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      perror(path.c_str());
+      close(fd);
+      return false;
+    }
+    this->size_ = st.st_size;
+    if (this->size_ > 0) {
+      void *map = mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {
+        perror(path.c_str());
+        close(fd);
+        return false;
+      }
+      madvise(map, this->size_, MADV_SEQUENTIAL);
+      this->data_ = static_cast<const uint8_t *>(map);
+    }
+    close(fd);
+    return true;
+  }
+
+  const uint8_t *data() const { return this->data_; }
+  size_t size() const { return this->size_; }
+
+ protected:
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+};
+
+// Deterministic synthetic capture with valid frames and occasional noise bytes
+std::vector<uint8_t> generate_capture(SensorType type, size_t size) {
+  std::vector<uint8_t> out;
+  out.reserve(size + 32);
+  uint32_t state = 12345;
+  auto next = [&state]() {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+  };
+  uint32_t frame = 0;
+  while (out.size() < size) {
+    if (frame++ % 50 == 49) {
+      out.push_back(next() & 0xFF);  // noise
+    }
+    switch (type) {
+      case SensorType::VOC: {
+        uint8_t data[esphome::two_one_voc::PACKET_SIZE];
+        data[0] = esphome::two_one_voc::HEADER_BYTE;
+        for (int i = 1; i < 11; i++) {
+          data[i] = next() & 0xFF;
+        }
+        data[11] = esphome::two_one_voc::frame_checksum(data);
+        out.insert(out.end(), data, data + sizeof(data));
+        break;
+      }
+      case SensorType::CO2: {
+        char line[esphome::jx_co2_102::MAX_LINE_LENGTH + 1];
+        int len = snprintf(line, sizeof(line), "  %u ppm\r\n", 400 + next() % 4600);
+        out.insert(out.end(), line, line + len);
+        break;
+      }
+      case SensorType::PM2005: {
+        // One measurement cycle: open response, particle data, mass data
+        uint8_t data[esphome::pm2005::PM2005_PARTICLE_DATA_LEN + 2];
+        for (int kind = 0; kind < 3; kind++) {
+          uint8_t len = kind == 0 ? 3 : esphome::pm2005::PM2005_MIN_DATA_LEN;
+          data[0] = esphome::pm2005::PM2005_RESP_HEADER;
+          data[1] = len;
+          data[2] = kind == 0 ? esphome::pm2005::PM2005_CMD_OPEN_CLOSE : esphome::pm2005::PM2005_CMD_READ_PARTICLE;
+          for (int i = 3; i < len + 2; i++) {
+            data[i] = kind == 0 ? 0x02 : next() & 0xFF;
+          }
+          uint16_t total = esphome::pm2005::pm2005_frame_length(len);
+          data[total - 1] = esphome::pm2005::pm2005_checksum(data, total - 1);
+          out.insert(out.end(), data, data + total);
+        }
+        break;
+      }
+    }
+  }
+  out.resize(size);
+  return out;
+}
+
+void append_int(std::string *out, int64_t value) {
+  char buffer[24];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out->append(buffer, result.ptr);
+}
+
+bool write_csv(FILE *file, SensorType type, const std::vector<std::vector<Record>> &chunks, unsigned threads) {
+  const auto &columns = column_names(type);
+  std::string header = "offset";
+  for (const char *column : columns) {
+    header += ',';
+    header += column;
+  }
+  header += '\n';
+  fwrite(header.data(), 1, header.size(), file);
+
+  // Format the chunks in parallel, write them in order
+  std::vector<std::string> text(chunks.size());
+  std::vector<std::thread> workers;
+  size_t next_chunk = 0;
+  while (next_chunk < chunks.size()) {
+    for (unsigned t = 0; t < threads && next_chunk < chunks.size(); t++, next_chunk++) {
+      workers.emplace_back([&, index = next_chunk]() {
+        std::string &out = text[index];
+        out.reserve(chunks[index].size() * (8 + columns.size() * 6));
+        for (const Record &record : chunks[index]) {
+          append_int(&out, static_cast<int64_t>(record.offset));
+          for (size_t c = 0; c < columns.size(); c++) {
+            out += ',';
+            append_int(&out, record.values[c]);
+          }
+          out += '\n';
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    workers.clear();
+  }
+  for (const std::string &chunk : text) {
+    if (fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Columnar binary: magic, u32 column count, u64 row count, per column
+// (u8 name length, name, u8 type) and then each column as a contiguous
+// little-endian array (offset is u64, sensor columns i64).
+bool write_binary(FILE *file, SensorType type, const std::vector<std::vector<Record>> &chunks) {
+  const auto &columns = column_names(type);
+  uint32_t column_count = columns.size() + 1;
+  uint64_t rows = count_records(chunks);
+  fwrite(BINARY_MAGIC, 1, sizeof(BINARY_MAGIC), file);
+  fwrite(&column_count, sizeof(column_count), 1, file);
+  fwrite(&rows, sizeof(rows), 1, file);
+
+  auto write_column_header = [file](const char *name, uint8_t column_type) {
+    uint8_t len = strlen(name);
+    fwrite(&len, 1, 1, file);
+    fwrite(name, 1, len, file);
+    fwrite(&column_type, 1, 1, file);
+  };
+  write_column_header("offset", COLUMN_U64);
+  for (const char *column : columns) {
+    write_column_header(column, COLUMN_I64);
+  }
+
+  std::vector<int64_t> buffer;
+  for (size_t c = 0; c <= columns.size(); c++) {
+    for (const auto &chunk : chunks) {
+      buffer.resize(chunk.size());
+      for (size_t i = 0; i < chunk.size(); i++) {
+        buffer[i] = c == 0 ? static_cast<int64_t>(chunk[i].offset) : chunk[i].values[c - 1];
+      }
+      if (fwrite(buffer.data(), sizeof(int64_t), buffer.size(), file) != buffer.size()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int run_decode(const Options &options) {
+  if (options.input.empty()) {
+    usage();
+    return 2;
+  }
+  MappedFile capture;
+  if (!capture.open(options.input)) {
+    return 1;
+  }
+
+  auto chunks = decode_parallel(options.type, capture.data(), capture.size(), options.threads);
+  fprintf(stderr, "Decoded %zu frames from %zu bytes\n", count_records(chunks), capture.size());
+
+  FILE *file = options.output.empty() || options.output == "-" ? stdout : fopen(options.output.c_str(), "wb");
+  if (file == nullptr) {
+    perror(options.output.c_str());
+    return 1;
+  }
+  bool ok;
+  if (options.format == "bin") {
+    ok = write_binary(file, options.type, chunks);
+  } else {
+    ok = write_csv(file, options.type, chunks, options.threads);
+  }
+  if (file != stdout) {
+    ok = fclose(file) == 0 && ok;
+  }
+  if (!ok) {
+    fprintf(stderr, "Failed to write output\n");
+    return 1;
+  }
+  return 0;
+}
+
+double measure(SensorType type, const uint8_t *data, size_t size, unsigned threads, unsigned repeat,
+               size_t *frames) {
+  double best = 0;
+  for (unsigned i = 0; i < repeat; i++) {
+    auto start = std::chrono::steady_clock::now();
+    auto chunks = decode_parallel(type, data, size, threads);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    *frames = count_records(chunks);
+    best = std::max(best, size / elapsed.count() / 1e9);
+  }
+  return best;
+}
+
+int run_bench(const Options &options) {
+  MappedFile capture;
+  std::vector<uint8_t> synthetic;
+  const uint8_t *data;
+  size_t size;
+  if (options.synthetic_size > 0) {
+    synthetic = generate_capture(options.type, options.synthetic_size);
+    data = synthetic.data();
+    size = synthetic.size();
+  } else if (!options.input.empty()) {
+    if (!capture.open(options.input)) {
+      return 1;
+    }
+    data = capture.data();
+    size = capture.size();
+    // Fault the mapping in so the first run is not measuring disk reads
+    volatile uint8_t sink = 0;
+    for (size_t i = 0; i < size; i += 4096) {
+      sink += data[i];
+    }
+  } else {
+    usage();
+    return 2;
+  }
+
+  size_t baseline_frames;
+  size_t parallel_frames;
+  double baseline = measure(options.type, data, size, 1, options.repeat, &baseline_frames);
+  double parallel = measure(options.type, data, size, options.threads, options.repeat, &parallel_frames);
+  printf("input:     %.1f MiB, %zu frames\n", size / 1048576.0, baseline_frames);
+  printf("1 thread:  %.2f GB/s\n", baseline);
+  printf("%u threads: %.2f GB/s (%.1fx)\n", options.threads, parallel, parallel / baseline);
+  if (baseline_frames != parallel_frames) {
+    fprintf(stderr, "Frame count mismatch: %zu (1 thread) vs %zu (%u threads)\n", baseline_frames, parallel_frames,
+            options.threads);
+    return 1;
+  }
+  return 0;
+}
+
+int run_generate(const Options &options) {
+  if (options.synthetic_size == 0 || options.output.empty()) {
+    usage();
+    return 2;
+  }
+  auto data = generate_capture(options.type, options.synthetic_size);
+  FILE *file = fopen(options.output.c_str(), "wb");
+  if (file == nullptr) {
+    perror(options.output.c_str());
+    return 1;
+  }
+  bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+  ok = fclose(file) == 0 && ok;
+  return ok ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parse_options(argc, argv, &options)) {
+    usage();
+    return 2;
+  }
+  if (options.command == "decode") {
+    return run_decode(options);
+  }
+  if (options.command == "bench") {
+    return run_bench(options);
+  }
+  if (options.command == "generate") {
+    return run_generate(options);
+  }
+  usage();
+  return 2;
+}